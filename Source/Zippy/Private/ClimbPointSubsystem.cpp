@@ -0,0 +1,167 @@
+#include "ClimbPointSubsystem.h"
+
+#include "EngineUtils.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+
+const FName UClimbPointSubsystem::ClimbPointTag = TEXT("Climb Point");
+
+void UClimbPointSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	UWorld* World = GetWorld();
+	ActorSpawnedHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &UClimbPointSubsystem::OnActorSpawned));
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UClimbPointSubsystem::OnLevelAdded);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &UClimbPointSubsystem::OnLevelRemoved);
+}
+
+void UClimbPointSubsystem::Deinitialize()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+	}
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+
+	Cells.Empty();
+	ClimbPointCells.Empty();
+
+	Super::Deinitialize();
+}
+
+void UClimbPointSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	for (TActorIterator<AActor> It(&InWorld); It; ++It)
+	{
+		if (It->ActorHasTag(ClimbPointTag))
+		{
+			RegisterClimbPoint(*It);
+		}
+	}
+}
+
+bool UClimbPointSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UClimbPointSubsystem::RegisterClimbPoint(AActor* ClimbPoint)
+{
+	if (!IsValid(ClimbPoint) || ClimbPointCells.Contains(ClimbPoint)) return;
+
+	const FVector Location = ClimbPoint->GetActorLocation();
+	const float Radius = ClimbPoint->GetComponentsBoundingBox(true).GetExtent().GetMax();
+	const FIntVector Cell = GetCell(Location);
+
+	Cells.FindOrAdd(Cell).Add({ ClimbPoint, Location, Radius });
+	ClimbPointCells.Add(ClimbPoint, Cell);
+	MaxClimbPointRadius = FMath::Max(MaxClimbPointRadius, Radius);
+
+	ClimbPoint->OnDestroyed.AddUniqueDynamic(this, &UClimbPointSubsystem::OnClimbPointDestroyed);
+}
+
+void UClimbPointSubsystem::UnregisterClimbPoint(AActor* ClimbPoint)
+{
+	FIntVector Cell;
+	if (!ClimbPointCells.RemoveAndCopyValue(ClimbPoint, Cell)) return;
+
+	if (TArray<FClimbPoint>* CellPoints = Cells.Find(Cell))
+	{
+		CellPoints->RemoveAllSwap([ClimbPoint](const FClimbPoint& Point) { return Point.Actor == ClimbPoint; });
+		if (CellPoints->IsEmpty())
+		{
+			Cells.Remove(Cell);
+		}
+	}
+
+	if (IsValid(ClimbPoint))
+	{
+		ClimbPoint->OnDestroyed.RemoveDynamic(this, &UClimbPointSubsystem::OnClimbPointDestroyed);
+	}
+}
+
+AActor* UClimbPointSubsystem::FindHighestClimbPoint(const FVector& Center, const FQuat& Rotation, const FVector& Extent) const
+{
+	const FBox QueryBounds = FBox(-Extent, Extent).TransformBy(FTransform(Rotation, Center)).ExpandBy(MaxClimbPointRadius);
+	const FIntVector MinCell = GetCell(QueryBounds.Min);
+	const FIntVector MaxCell = GetCell(QueryBounds.Max);
+
+	AActor* ClimbPoint = nullptr;
+	float MaxHeight = -1e20;
+	for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+	for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+	for (int32 Z = MinCell.Z; Z <= MaxCell.Z; Z++)
+	{
+		const TArray<FClimbPoint>* CellPoints = Cells.Find(FIntVector(X, Y, Z));
+		if (!CellPoints) continue;
+
+		for (const FClimbPoint& Point : *CellPoints)
+		{
+			if (Point.Location.Z <= MaxHeight) continue;
+
+			const FVector LocalLocation = Rotation.UnrotateVector(Point.Location - Center);
+			if (FMath::Abs(LocalLocation.X) > Extent.X + Point.Radius
+				|| FMath::Abs(LocalLocation.Y) > Extent.Y + Point.Radius
+				|| FMath::Abs(LocalLocation.Z) > Extent.Z + Point.Radius) continue;
+
+			if (AActor* Actor = Point.Actor.Get())
+			{
+				MaxHeight = Point.Location.Z;
+				ClimbPoint = Actor;
+			}
+		}
+	}
+
+	return ClimbPoint;
+}
+
+FIntVector UClimbPointSubsystem::GetCell(const FVector& Location) const
+{
+	return FIntVector(
+		FMath::FloorToInt32(Location.X / CellSize),
+		FMath::FloorToInt32(Location.Y / CellSize),
+		FMath::FloorToInt32(Location.Z / CellSize));
+}
+
+void UClimbPointSubsystem::OnActorSpawned(AActor* Actor)
+{
+	if (Actor && Actor->ActorHasTag(ClimbPointTag))
+	{
+		RegisterClimbPoint(Actor);
+	}
+}
+
+void UClimbPointSubsystem::OnLevelAdded(ULevel* Level, UWorld* InWorld)
+{
+	if (InWorld != GetWorld() || !Level) return;
+
+	for (AActor* Actor : Level->Actors)
+	{
+		if (Actor && Actor->ActorHasTag(ClimbPointTag))
+		{
+			RegisterClimbPoint(Actor);
+		}
+	}
+}
+
+void UClimbPointSubsystem::OnLevelRemoved(ULevel* Level, UWorld* InWorld)
+{
+	if (InWorld != GetWorld() || !Level) return;
+
+	for (AActor* Actor : Level->Actors)
+	{
+		if (Actor && ClimbPointCells.Contains(Actor))
+		{
+			UnregisterClimbPoint(Actor);
+		}
+	}
+}
+
+void UClimbPointSubsystem::OnClimbPointDestroyed(AActor* DestroyedActor)
+{
+	UnregisterClimbPoint(DestroyedActor);
+}
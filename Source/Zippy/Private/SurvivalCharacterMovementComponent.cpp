@@ -1,18 +1,30 @@
 #include "SurvivalCharacterMovementComponent.h"
 
+#include "ClimbPointSubsystem.h"
+#include "SurvivalMovementBatch.h"
+#include "SurvivalMovementBenchmark.h"
+#include "SurvivalMovementSignificance.h"
+#include "SurvivalMovementStats.h"
+#include "SurvivalMovementValidation.h"
 #include "ZippyCharacter.h"
+#include "Camera/PlayerCameraManager.h"
 #include "Components/CapsuleComponent.h"
-#include "Engine/OverlapResult.h"
+#include "DrawDebugHelpers.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
 #include "GameFramework/Character.h"
+#include "GameFramework/GameNetworkManager.h"
+#include "GameFramework/PlayerController.h"
 #include "Net/UnrealNetwork.h"
-
-// Helper Macros
-#if 0
-float MacroDuration = 2.f;
-#define SLOG(x) GEngine->AddOnScreenDebugMessage(-1, MacroDuration ? MacroDuration : -1.f, FColor::Yellow, x);
-#define POINT(x, c) DrawDebugPoint(GetWorld(), x, 10, c, !MacroDuration, MacroDuration);
-#define LINE(x1, x2, c) DrawDebugLine(GetWorld(), x1, x2, c, !MacroDuration, MacroDuration);
-#define CAPSULE(x, c) DrawDebugCapsule(GetWorld(), x, CapHH(), CapR(), FQuat::Identity, c, !MacroDuration, MacroDuration);
+#include "SignificanceManager.h"
+
+// Helper Macros, drawn for the viewed character while zippy.Movement.Debug is set. Arguments are only evaluated when drawing.
+#if SURVIVAL_MOVEMENT_DEBUG
+static constexpr float MacroDuration = 2.f;
+#define SLOG(x) do { if (SurvivalMovementDebug::ShouldDraw(CharacterOwner)) GEngine->AddOnScreenDebugMessage(-1, MacroDuration, FColor::Yellow, FString(x)); } while (0);
+#define POINT(x, c) do { if (SurvivalMovementDebug::ShouldDraw(CharacterOwner)) DrawDebugPoint(GetWorld(), x, 10, c, false, MacroDuration); } while (0);
+#define LINE(x1, x2, c) do { if (SurvivalMovementDebug::ShouldDraw(CharacterOwner)) DrawDebugLine(GetWorld(), x1, x2, c, false, MacroDuration); } while (0);
+#define CAPSULE(x, c) do { if (SurvivalMovementDebug::ShouldDraw(CharacterOwner)) DrawDebugCapsule(GetWorld(), x, CapHH(), CapR(), FQuat::Identity, c, false, MacroDuration); } while (0);
 #else
 #define SLOG(x)
 #define POINT(x, c)
@@ -22,10 +34,20 @@ float MacroDuration = 2.f;
 
 // A tolerance for values like velocity as they will never be exactly equal on the server and client.
 #define SERVER_TOLERANCE 2.5f
+// Facing a cached mantle search stays valid for, about 5 degrees of turn.
+#define MANTLE_CACHE_MIN_FORWARD_DOT .996f
+// Normals this close belong to the same floor face when carrying a floor result over to the next move.
+#define ADJACENT_FLOOR_MIN_NORMAL_DOT .9999f
+// How far a move's horizontal delta can fall short, in cm, and still count as a clean move along the floor.
+#define ADJACENT_FLOOR_MOVE_TOLERANCE .1f
+// Gap, in cm, wall attraction leaves between the capsule and the wall it pulls towards.
+#define WALL_CONTACT_SKIN .5f
 // Does a guard against a simulated proxy code below this will not run on a simulated proxy's.
 #define DO_SIM_PROXY_GUARD(RETVAL) if (CharacterOwner && CharacterOwner->GetLocalRole() == ROLE_SimulatedProxy) return RETVAL
 // A guard against a simulated proxy if true we are a simulated proxy.
 #define SIM_PROXY_GUARD CharacterOwner && CharacterOwner->GetLocalRole() == ROLE_SimulatedProxy
+// Counts scene queries against the current movement mode for stat SurvivalMovement.
+#define COUNT_TRACES(Count) SURVIVAL_COUNT_TRACES(MovementMode, CustomMovementMode, Count)
 
 DEFINE_LOG_CATEGORY(LogSurvivalCharacterMovement);
 
@@ -36,8 +58,15 @@ USurvivalCharacterMovementComponent::FSavedMove_SurvivalCharacter::FSavedMove_Su
 {
 	Saved_bWantsToSprint=0;
 	Saved_bWantsToSlide=0;
+	Saved_bCrouchHeld=0;
 	Saved_bWantsToProne=0;
 	Saved_bPrevWantsToCrouch=0;
+	Saved_CrouchHoldTime=0.f;
+	Saved_DashCooldownLeft=0.f;
+	Saved_bDashed=0;
+
+	DefaultAccelDotThresholdCombine = AccelDotThresholdCombine;
+	DefaultAccelMagThreshold = AccelMagThreshold;
 }
 
 bool USurvivalCharacterMovementComponent::FSavedMove_SurvivalCharacter::CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* InCharacter, float MaxDelta) const
@@ -60,10 +89,43 @@ bool USurvivalCharacterMovementComponent::FSavedMove_SurvivalCharacter::CanCombi
 	{
 		return false;
 	}
+	if (Saved_bCrouchHeld != NewSurvivalMove->Saved_bCrouchHeld || Saved_bWantsToProne != NewSurvivalMove->Saved_bWantsToProne)
+	{
+		return false;
+	}
+	if (Saved_bPressedZippyJump != NewSurvivalMove->Saved_bPressedZippyJump)
+	{
+		return false;
+	}
+	if (Saved_bTransitionFinished != NewSurvivalMove->Saved_bTransitionFinished)
+	{
+		return false;
+	}
+	if (Saved_Transition != NewSurvivalMove->Saved_Transition || Saved_QueuedTransition != NewSurvivalMove->Saved_QueuedTransition)
+	{
+		return false;
+	}
+	// Steady and non steady moves never share a movement mode, the base check below rejects them on the mode change.
 	
 	return FSavedMove_Character::CanCombineWith(NewMove, InCharacter, MaxDelta);
 }
 
+void USurvivalCharacterMovementComponent::FSavedMove_SurvivalCharacter::CombineWith(const FSavedMove_Character* OldMove, ACharacter* InCharacter, APlayerController* PC, const FVector& OldStartLocation)
+{
+	FSavedMove_Character::CombineWith(OldMove, InCharacter, PC, OldStartLocation);
+
+	const FSavedMove_SurvivalCharacter* OldSurvivalMove = static_cast<const FSavedMove_SurvivalCharacter*>(OldMove);
+	USurvivalCharacterMovementComponent* CharacterMovement = Cast<USurvivalCharacterMovementComponent>(InCharacter->GetCharacterMovement());
+
+	// The combined move runs again from the pending move's start, over both moves' time
+	CharacterMovement->Safe_CrouchHoldTime = Saved_CrouchHoldTime = OldSurvivalMove->Saved_CrouchHoldTime;
+	CharacterMovement->Safe_DashCooldownLeft = Saved_DashCooldownLeft = OldSurvivalMove->Saved_DashCooldownLeft;
+	CharacterMovement->FixedStepRemainder = Saved_FixedStepRemainder = OldSurvivalMove->Saved_FixedStepRemainder;
+
+	// The pending move was captured already, the combined move replaces it
+	CharacterMovement->bCaptureCombinedMove = true;
+}
+
 void USurvivalCharacterMovementComponent::FSavedMove_SurvivalCharacter::Clear()
 {
 	FSavedMove_Character::Clear();
@@ -75,11 +137,20 @@ void USurvivalCharacterMovementComponent::FSavedMove_SurvivalCharacter::Clear()
 
 	Saved_bHadAnimRootMotion = 0;
 	Saved_bTransitionFinished = 0;
+	Saved_Transition = 0;
+	Saved_QueuedTransition = 0;
+	Saved_TransitionRMS_ID = 0;
+	Saved_FixedStepRemainder = 0.f;
+	Saved_ProbeFailures = 0;
 	
+	Saved_bCrouchHeld = 0;
 	Saved_bWantsToProne = 0;
 	Saved_bPrevWantsToCrouch = 0;
+	Saved_CrouchHoldTime = 0.f;
+	Saved_DashCooldownLeft = 0.f;
 
 	Saved_bWallRunIsRight = 0;
+	Saved_bDashed = 0;
 }
 
 uint8 USurvivalCharacterMovementComponent::FSavedMove_SurvivalCharacter::GetCompressedFlags() const
@@ -107,11 +178,30 @@ void USurvivalCharacterMovementComponent::FSavedMove_SurvivalCharacter::SetMoveF
 
 	Saved_bHadAnimRootMotion = CharacterMovement->Safe_bHadAnimRootMotion;
 	Saved_bTransitionFinished = CharacterMovement->Safe_bTransitionFinished;
+	Saved_Transition = static_cast<uint8>(CharacterMovement->Safe_Transition);
+	Saved_QueuedTransition = static_cast<uint8>(CharacterMovement->Safe_QueuedTransition);
+	Saved_TransitionRMS_ID = CharacterMovement->TransitionRMS_ID;
+	Saved_FixedStepRemainder = CharacterMovement->FixedStepRemainder;
 
+	Saved_bCrouchHeld = CharacterMovement->Safe_bCrouchHeld;
 	Saved_bWantsToProne = CharacterMovement->Safe_bWantsToProne;
 	Saved_bWantsToDash = CharacterMovement->Safe_bWantsToDash;
+	Saved_CrouchHoldTime = CharacterMovement->Safe_CrouchHoldTime;
+	Saved_DashCooldownLeft = CharacterMovement->Safe_DashCooldownLeft;
 
 	Saved_bWallRunIsRight = CharacterMovement->Safe_bWallRunIsRight;
+
+	// While a custom mode is steady the acceleration barely changes between ticks, loosen the thresholds so those moves combine.
+	if (CharacterMovement->IsInSteadyCombineMode())
+	{
+		AccelDotThresholdCombine = CharacterMovement->SteadyMoveAccelDotThresholdCombine;
+		AccelMagThreshold = CharacterMovement->SteadyMoveAccelMagThreshold;
+	}
+	else
+	{
+		AccelDotThresholdCombine = DefaultAccelDotThresholdCombine;
+		AccelMagThreshold = DefaultAccelMagThreshold;
+	}
 }
 
 void USurvivalCharacterMovementComponent::FSavedMove_SurvivalCharacter::PrepMoveFor(ACharacter* C)
@@ -127,11 +217,46 @@ void USurvivalCharacterMovementComponent::FSavedMove_SurvivalCharacter::PrepMove
 
 	CharacterMovement->Safe_bHadAnimRootMotion = Saved_bHadAnimRootMotion;
 	CharacterMovement->Safe_bTransitionFinished = Saved_bTransitionFinished;
+	CharacterMovement->Safe_Transition = static_cast<ESurvivalTransition>(Saved_Transition);
+	CharacterMovement->Safe_QueuedTransition = static_cast<ESurvivalTransition>(Saved_QueuedTransition);
+	CharacterMovement->TransitionRMS_ID = Saved_TransitionRMS_ID;
+	CharacterMovement->FixedStepRemainder = Saved_FixedStepRemainder;
 
+	CharacterMovement->Safe_bCrouchHeld = Saved_bCrouchHeld;
 	CharacterMovement->Safe_bWantsToProne = Saved_bWantsToProne;
 	CharacterMovement->Safe_bWantsToDash = Saved_bWantsToDash;
+	CharacterMovement->Safe_CrouchHoldTime = Saved_CrouchHoldTime;
+	CharacterMovement->Safe_DashCooldownLeft = Saved_DashCooldownLeft;
 
 	CharacterMovement->Safe_bWallRunIsRight = Saved_bWallRunIsRight;
+
+	CharacterMovement->ReplayProbeFailures = Saved_ProbeFailures;
+	CharacterMovement->bReplayProbeDecisions = CharacterMovement->bClientUpdating
+		&& FVector::PointsAreNear(CharacterMovement->UpdatedComponent->GetComponentLocation(), StartLocation, CharacterMovement->ProbeReplayTolerance);
+}
+
+void USurvivalCharacterMovementComponent::FSavedMove_SurvivalCharacter::PostUpdate(ACharacter* C, EPostUpdateMode PostUpdateMode)
+{
+	FSavedMove_Character::PostUpdate(C, PostUpdateMode);
+
+	USurvivalCharacterMovementComponent* CharacterMovement = Cast<USurvivalCharacterMovementComponent>(C->GetCharacterMovement());
+
+	Saved_ProbeFailures = CharacterMovement->ProbeFailures;
+	if (PostUpdateMode == PostUpdate_Record) Saved_bDashed = CharacterMovement->bDashedThisMove;
+
+	if (PostUpdateMode == PostUpdate_Record && CharacterMovement->CaptureWriter) CharacterMovement->CaptureMove(*this);
+}
+
+uint8 USurvivalCharacterMovementComponent::FSavedMove_SurvivalCharacter::GetSurvivalFlags() const
+{
+	uint8 SurvivalFlags = 0;
+	if (Saved_bCrouchHeld) SurvivalFlags |= FSurvivalNetworkMoveData::SFLAG_CrouchHeld;
+	if (Saved_bWantsToProne) SurvivalFlags |= FSurvivalNetworkMoveData::SFLAG_WantsToProne;
+	if (Saved_bWallRunIsRight) SurvivalFlags |= FSurvivalNetworkMoveData::SFLAG_WallRunIsRight;
+	if (Saved_bTransitionFinished) SurvivalFlags |= FSurvivalNetworkMoveData::SFLAG_TransitionFinished;
+	if (Saved_bPrevWantsToCrouch) SurvivalFlags |= FSurvivalNetworkMoveData::SFLAG_PrevWantsToCrouch;
+	if (Saved_bDashed) SurvivalFlags |= FSurvivalNetworkMoveData::SFLAG_Dashed;
+	return SurvivalFlags;
 }
 
 #pragma endregion
@@ -150,27 +275,159 @@ FSavedMovePtr USurvivalCharacterMovementComponent::FNetworkPredictionData_Client
 
 #pragma endregion
 
+#pragma region Network Move Data
+
+void USurvivalCharacterMovementComponent::FSurvivalNetworkMoveData::ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove, ENetworkMoveType MoveType)
+{
+	FCharacterNetworkMoveData::ClientFillNetworkMoveData(ClientMove, MoveType);
+
+	const FSavedMove_SurvivalCharacter& SurvivalMove = static_cast<const FSavedMove_SurvivalCharacter&>(ClientMove);
+
+	SurvivalFlags = SurvivalMove.GetSurvivalFlags();
+
+	bCoarseLocation = false;
+	if (const ACharacter* Character = ClientMove.CharacterOwner.Get())
+	{
+		TEnumAsByte<EMovementMode> EndMode, EndGroundMode;
+		uint8 EndCustomMode;
+		Character->GetCharacterMovement()->UnpackNetworkMovementMode(ClientMove.EndPackedMovementMode, EndMode, EndCustomMode, EndGroundMode);
+		bCoarseLocation = EndMode == MOVE_Custom;
+	}
+}
+
+bool USurvivalCharacterMovementComponent::FSurvivalNetworkMoveData::Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap, ENetworkMoveType MoveType)
+{
+	NetworkMoveType = MoveType;
+	bool bLocalSuccess = true;
+	const bool bIsSaving = Ar.IsSaving();
+	const FSurvivalNetworkMoveData* Base = MoveType == ENetworkMoveType::NewMove ? nullptr : DeltaBase;
+	check(MoveType == ENetworkMoveType::NewMove || Base);
+
+	// Writes one bit telling if the value matches the base move, the full value is only sent when it does not.
+	auto SerializeDelta = [&Ar, bIsSaving, Base](auto& Value, auto BaseValue, auto&& SerializeValue)
+	{
+		bool bSameAsBase = false;
+		if (Base)
+		{
+			bSameAsBase = bIsSaving && Value == BaseValue;
+			Ar.SerializeBits(&bSameAsBase, 1);
+		}
+
+		if (!bSameAsBase)
+		{
+			SerializeValue();
+		}
+		else if (!bIsSaving)
+		{
+			Value = BaseValue;
+		}
+	};
+
+	Ar << TimeStamp;
+
+	SerializeDelta(Acceleration, Base ? Base->Acceleration : FVector_NetQuantize10(), [&]()
+	{
+		uint8 Precision = AccelPrecision_Tenth;
+		if (bIsSaving)
+		{
+			if (Acceleration.IsZero()) Precision = AccelPrecision_Zero;
+			else if (Acceleration.Equals(FVector(FMath::RoundToFloat(Acceleration.X), FMath::RoundToFloat(Acceleration.Y), FMath::RoundToFloat(Acceleration.Z)), 0.f)) Precision = AccelPrecision_Whole;
+		}
+		Ar.SerializeBits(&Precision, 2);
+
+		if (Precision == AccelPrecision_Zero)
+		{
+			Acceleration = FVector::ZeroVector;
+		}
+		else if (Precision == AccelPrecision_Whole)
+		{
+			FVector_NetQuantize WholeAccel = Acceleration;
+			WholeAccel.NetSerialize(Ar, PackageMap, bLocalSuccess);
+			Acceleration = WholeAccel;
+		}
+		else
+		{
+			Acceleration.NetSerialize(Ar, PackageMap, bLocalSuccess);
+		}
+	});
+
+	SerializeDelta(ControlRotation, Base ? Base->ControlRotation : FRotator(), [&]()
+	{
+		ControlRotation.NetSerialize(Ar, PackageMap, bLocalSuccess);
+	});
+
+	SerializeDelta(CompressedMoveFlags, Base ? Base->CompressedMoveFlags : uint8(0), [&]()
+	{
+		SerializeOptionalValue<uint8>(bIsSaving, Ar, CompressedMoveFlags, 0);
+	});
+
+	SerializeDelta(SurvivalFlags, Base ? Base->SurvivalFlags : uint8(0), [&]()
+	{
+		Ar.SerializeBits(&SurvivalFlags, SurvivalFlagBits);
+	});
+
+	if (MoveType == ENetworkMoveType::NewMove)
+	{
+		// Location, relative movement base, and ending movement mode is only used for error checking, so only save for the final move.
+		Ar.SerializeBits(&bCoarseLocation, 1);
+		if (bCoarseLocation)
+		{
+			FVector_NetQuantize10 CoarseLocation = Location;
+			CoarseLocation.NetSerialize(Ar, PackageMap, bLocalSuccess);
+			Location = CoarseLocation;
+		}
+		else
+		{
+			Location.NetSerialize(Ar, PackageMap, bLocalSuccess);
+		}
+
+		SerializeOptionalValue<UPrimitiveComponent*>(bIsSaving, Ar, MovementBase, nullptr);
+		SerializeOptionalValue<FName>(bIsSaving, Ar, MovementBaseBoneName, NAME_None);
+		SerializeOptionalValue<uint8>(bIsSaving, Ar, MovementMode, MOVE_Walking);
+	}
+	else if (!bIsSaving)
+	{
+		// Not used by the server for pending and old moves, keep it from holding a stale value.
+		Location = Base->Location;
+	}
+
+	return bLocalSuccess && !Ar.IsError();
+}
+
+USurvivalCharacterMovementComponent::FSurvivalNetworkMoveDataContainer::FSurvivalNetworkMoveDataContainer()
+{
+	MoveData[1].DeltaBase = &MoveData[0];
+	MoveData[2].DeltaBase = &MoveData[0];
+	SetNetworkMoveDataReferences(MoveData[0], MoveData[1], MoveData[2]);
+}
+
+#pragma endregion
+
 USurvivalCharacterMovementComponent::USurvivalCharacterMovementComponent()
 {
 	bCanWalkOffLedgesWhenCrouching = true;
 	NavAgentProps.bCanCrouch = true;
 	SurvivalServerMoveBitWriter.SetAllowResize(true);
+	SetNetworkMoveDataContainer(SurvivalMoveDataContainer);
 }
 
 void USurvivalCharacterMovementComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
+	bProxyLowDetail = SIM_PROXY_GUARD && ComputeProxyLowDetail();
+
+	if (CharacterOwner && CharacterOwner->IsLocallyControlled()) ApplyBufferedInputs();
+
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
-	TickCount++;
-	if (IsNetMode(NM_Client))
-	{
-		GEngine->AddOnScreenDebugMessage(2, 100.f, FColor::Yellow, FString::Printf(TEXT("Correction: %.2f"), 100.f * static_cast<float>(CorrectionCount) / static_cast<float>(TickCount)));
-		GEngine->AddOnScreenDebugMessage(9, 100.f, FColor::Yellow, FString::Printf(TEXT("Bitrate: %.3f"), static_cast<float>(TotalBitsSent) / GetWorld()->GetTimeSeconds() / 1000.f));
-	}
-	else
+	UpdateFixedStepVisuals();
+
+	if (PendingCosmeticEvents)
 	{
-		GEngine->AddOnScreenDebugMessage(3, 100.f, FColor::Yellow, FString::Printf(TEXT("Location Error: %.4f cm/s"), 100.f * AccumulatedClientLocationError / GetWorld()->GetTimeSeconds()));
+		Multicast_CosmeticEvents(PendingCosmeticEvents);
+		PendingCosmeticEvents = 0;
 	}
+
+	TickCount++;
 }
 
 #pragma region CMC
@@ -180,6 +437,139 @@ void USurvivalCharacterMovementComponent::InitializeComponent()
 	Super::InitializeComponent();
 
 	ZippyCharacterOwner = Cast<AZippyCharacter>(GetOwner());
+	RefreshDerivedConstants();
+	RefreshTuningCurves();
+	ServerPositionErrorBudgetLeft = ServerPositionErrorBudget;
+
+	PrefetchTraceDelegate.BindUObject(this, &USurvivalCharacterMovementComponent::OnPrefetchTraceDone);
+
+	// A mantle chained into a hang needs two sources alive at once
+	TransitionRMSPool.Reset();
+	TransitionRMSPool.Add(MakeShared<FRootMotionSource_MoveToForce>());
+	TransitionRMSPool.Add(MakeShared<FRootMotionSource_MoveToForce>());
+
+	HitScratch.Reserve(HitScratchCapacity);
+}
+
+void USurvivalCharacterMovementComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	RefreshControllerRegistration();
+
+	if (GetOwnerRole() == ROLE_AutonomousProxy && SurvivalMovementCapture::ShouldCaptureSession())
+	{
+		const FString Filename = FSurvivalMovementCaptureWriter::GetCaptureDir() / FString::Printf(TEXT("%s_%s.zmc"), *GetOwner()->GetName(), *FDateTime::Now().ToString());
+		CaptureWriter = MakeUnique<FSurvivalMovementCaptureWriter>(Filename, GetWorld()->GetOutermost()->GetName(), SurvivalMovementCapture::GetMaxBytes());
+		if (!CaptureWriter->IsOpen()) CaptureWriter.Reset();
+		UE_CLOG(CaptureWriter.IsValid(), LogSurvivalCharacterMovement, Log, TEXT("Capturing movement to %s"), *Filename);
+	}
+}
+
+void USurvivalCharacterMovementComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	SetBatchedProbesRegistered(false);
+
+	if (CaptureWriter)
+	{
+		UE_CLOG(CaptureWriter->GetDropped() > 0, LogSurvivalCharacterMovement, Warning, TEXT("Movement capture dropped %d records, the writer fell behind"), CaptureWriter->GetDropped());
+		CaptureWriter.Reset();
+	}
+
+	SetSignificanceRegistered(false);
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void USurvivalCharacterMovementComponent::RefreshControllerRegistration()
+{
+	if (!HasBegunPlay() || !CharacterOwner) return;
+
+	// Player pawns are often possessed after BeginPlay, so this is decided again whenever the controller changes
+	const bool bServerAI = GetOwnerRole() == ROLE_Authority && !CharacterOwner->IsPlayerControlled();
+	SetBatchedProbesRegistered(bBatchServerProbes && bServerAI);
+	SetSignificanceRegistered(bUseMovementSignificance && (bServerAI || GetOwnerRole() == ROLE_SimulatedProxy));
+}
+
+void USurvivalCharacterMovementComponent::SetBatchedProbesRegistered(bool bRegister)
+{
+	if (bRegister == bBatchedProbes) return;
+
+	USurvivalMovementBatchSubsystem* Batch = GetWorld()->GetSubsystem<USurvivalMovementBatchSubsystem>();
+	if (bRegister)
+	{
+		if (!Batch) return;
+		Batch->Register(this);
+	}
+	else if (Batch)
+	{
+		Batch->Unregister(this);
+	}
+	bBatchedProbes = bRegister;
+}
+
+void USurvivalCharacterMovementComponent::SetSignificanceRegistered(bool bRegister)
+{
+	if (bRegister == bSignificanceRegistered) return;
+
+	USignificanceManager* SignificanceManager = USignificanceManager::Get(GetWorld());
+	USurvivalMovementSignificanceSubsystem* Significance = GetWorld()->GetSubsystem<USurvivalMovementSignificanceSubsystem>();
+	if (bRegister)
+	{
+		if (!SignificanceManager || !Significance) return;
+
+		SignificanceManager->RegisterObject(this, USurvivalMovementSignificanceSubsystem::SignificanceTag,
+			[](USignificanceManager::FManagedObjectInfo* Info, const FTransform& Viewpoint)
+			{
+				return CastChecked<USurvivalCharacterMovementComponent>(Info->GetObject())->CalculateSignificance(Viewpoint);
+			},
+			USignificanceManager::EPostSignificanceType::Sequential,
+			[](USignificanceManager::FManagedObjectInfo* Info, float OldSignificance, float NewSignificance, bool bFinal)
+			{
+				CastChecked<USurvivalCharacterMovementComponent>(Info->GetObject())->ApplySignificance(NewSignificance);
+			});
+		Significance->AddRegistered();
+	}
+	else
+	{
+		if (SignificanceManager) SignificanceManager->UnregisterObject(this);
+		if (Significance) Significance->RemoveRegistered();
+
+		// Leave the reduced tick rate and coarse steps behind with the registration
+		ApplySignificance(Significance_Full);
+	}
+	bSignificanceRegistered = bRegister;
+}
+
+#if WITH_EDITOR
+void USurvivalCharacterMovementComponent::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	RefreshDerivedConstants();
+	RefreshTuningCurves();
+}
+#endif
+
+void USurvivalCharacterMovementComponent::RefreshDerivedConstants()
+{
+	Derived.CosMantleMinWallSteepnessAngle = FMath::Cos(FMath::DegreesToRadians(MantleMinWallSteepnessAngle));
+	Derived.CosMantleMaxSurfaceAngle = FMath::Cos(FMath::DegreesToRadians(MantleMaxSurfaceAngle));
+	Derived.CosMantleMaxAlignmentAngle = FMath::Cos(FMath::DegreesToRadians(MantleMaxAlignmentAngle));
+
+	Derived.SinWallRunPullAwayAngle = FMath::Sin(FMath::DegreesToRadians(WallRunPullAwayAngle));
+
+	Derived.MinSlideSpeedSquared = FMath::Square(MinSlideSpeed);
+	Derived.MinWallRunSpeedSquared = FMath::Square(MinWallRunSpeed);
+}
+
+void USurvivalCharacterMovementComponent::RefreshTuningCurves()
+{
+	WallRunGravityScale.Bake(WallRunGravityScaleCurve, 1.f);
+	if (!WallRunGravityScale.IsBakedFromCurve())
+	{
+		UE_LOG(LogSurvivalCharacterMovement, Warning, TEXT("%s has no WallRunGravityScaleCurve keys, wall runs use full gravity"), *GetPathName());
+	}
 }
 
 // Network
@@ -192,6 +582,36 @@ void USurvivalCharacterMovementComponent::UpdateFromCompressedFlags(uint8 Flags)
 	Safe_bWantsToSlide = (Flags & FSavedMove_SurvivalCharacter::FLAG_Slide) != 0;
 }
 
+void USurvivalCharacterMovementComponent::MoveAutonomous(float ClientTimeStamp, float DeltaTime, uint8 CompressedFlags, const FVector& NewAccel)
+{
+	if (const FSurvivalNetworkMoveData* MoveData = static_cast<const FSurvivalNetworkMoveData*>(GetCurrentNetworkMoveData()))
+	{
+		// Inputs are taken from the client
+		ApplySurvivalInputFlags(MoveData->SurvivalFlags);
+
+		// Only used to count dashes the server turns down
+		bClientDashed = (MoveData->SurvivalFlags & FSurvivalNetworkMoveData::SFLAG_Dashed) != 0;
+
+		// State is ours to decide. A correction cannot carry it back to the client, so a disagreement is only counted
+		// and the position check decides whether the divergence matters
+		const bool bClientTransitionFinished = (MoveData->SurvivalFlags & FSurvivalNetworkMoveData::SFLAG_TransitionFinished) != 0;
+		const bool bClientWallRunIsRight = (MoveData->SurvivalFlags & FSurvivalNetworkMoveData::SFLAG_WallRunIsRight) != 0;
+		if (bClientTransitionFinished != Safe_bTransitionFinished || (IsWallRunning() && bClientWallRunIsRight != Safe_bWallRunIsRight))
+		{
+			ServerValidationTelemetry.StateMismatches++;
+		}
+	}
+
+	Super::MoveAutonomous(ClientTimeStamp, DeltaTime, CompressedFlags, NewAccel);
+}
+
+void USurvivalCharacterMovementComponent::ApplySurvivalInputFlags(uint8 SurvivalFlags)
+{
+	Safe_bCrouchHeld = (SurvivalFlags & FSurvivalNetworkMoveData::SFLAG_CrouchHeld) != 0;
+	Safe_bWantsToProne = (SurvivalFlags & FSurvivalNetworkMoveData::SFLAG_WantsToProne) != 0;
+	Safe_bPrevWantsToCrouch = (SurvivalFlags & FSurvivalNetworkMoveData::SFLAG_PrevWantsToCrouch) != 0;
+}
+
 void USurvivalCharacterMovementComponent::OnClientCorrectionReceived(FNetworkPredictionData_Client_Character& ClientData,
 float TimeStamp, FVector NewLocation, FVector NewVelocity, UPrimitiveComponent* NewBase, FName NewBaseBoneName,
 bool bHasBase, bool bBaseRelativePosition, uint8 ServerMovementMode, FVector ServerGravityDirection)
@@ -200,6 +620,25 @@ bool bHasBase, bool bBaseRelativePosition, uint8 ServerMovementMode, FVector Ser
 	bHasBase, bBaseRelativePosition, ServerMovementMode, ServerGravityDirection);
 
 	CorrectionCount++;
+	InvalidateSurfaceContacts();
+	InvalidateProbeBatch();
+	MantleCache.Time = -1.;
+
+	if (CaptureWriter)
+	{
+		FSurvivalMoveCaptureRecord Record;
+		Record.Type = FSurvivalMoveCaptureRecord::Type_Correction;
+		Record.TimeStamp = TimeStamp;
+		Record.StartPackedMode = Record.EndPackedMode = ServerMovementMode;
+		Record.Location = FVector3f(NewLocation);
+		Record.Velocity = FVector3f(NewVelocity);
+		Record.Rotation = FRotator3f(UpdatedComponent->GetComponentRotation());
+		CaptureWriter->Push(Record);
+	}
+
+#if SURVIVAL_MOVEMENT_STATS
+	SurvivalMovementStats::CountClientCorrection();
+#endif
 }
 
 
@@ -233,43 +672,15 @@ float USurvivalCharacterMovementComponent::GetMaxSpeed() const
 	
 	if (MovementMode != MOVE_Custom) return Super::GetMaxSpeed();
 
-	switch (CustomMovementMode)
-	{
-	case CMOVE_Slide:
-		return MaxSlideSpeed;
-	case CMOVE_Prone:
-		return MaxProneSpeed;
-	case CMOVE_WallRun:
-		return MaxWallRunSpeed;
-	case CMOVE_Hang:
-		return 0.f;
-	case CMOVE_Climb:
-		return MaxClimbSpeed;
-	default:
-		UE_LOG(LogTemp, Fatal, TEXT("Invalid Movement Mode"))
-		return -1.f;
-	}
+	const FModeDescriptor& Mode = GetModeDescriptor(CustomMovementMode);
+	return Mode.MaxSpeed ? this->*Mode.MaxSpeed : 0.f;
 }
 float USurvivalCharacterMovementComponent::GetMaxBrakingDeceleration() const
 {
 	if (MovementMode != MOVE_Custom) return Super::GetMaxBrakingDeceleration();
 
-	switch (CustomMovementMode)
-	{
-	case CMOVE_Slide:
-		return BrakingDecelerationSliding;
-	case CMOVE_Prone:
-		return BrakingDecelerationProning;
-	case CMOVE_WallRun:
-		return 0.f;
-	case CMOVE_Hang:
-		return 0.f;
-	case CMOVE_Climb:
-		return BrakingDecelerationClimbing;
-	default:
-		UE_LOG(LogTemp, Fatal, TEXT("Invalid Movement Mode"))
-		return -1.f;
-	}
+	const FModeDescriptor& Mode = GetModeDescriptor(CustomMovementMode);
+	return Mode.BrakingDeceleration ? this->*Mode.BrakingDeceleration : 0.f;
 }
 
 bool USurvivalCharacterMovementComponent::CanAttemptJump() const
@@ -288,8 +699,9 @@ bool USurvivalCharacterMovementComponent::DoJump(bool bReplayingMoves)
 			FVector Start = UpdatedComponent->GetComponentLocation();
 			FVector CastDelta = UpdatedComponent->GetRightVector() * CapR() * 2;
 			FVector End = Safe_bWallRunIsRight ? Start + CastDelta : Start - CastDelta;
-			auto Params = ZippyCharacterOwner->GetIgnoreCharacterParams();
+			const FCollisionQueryParams& Params = ZippyCharacterOwner->GetIgnoreCharacterParams();
 			FHitResult WallHit;
+			COUNT_TRACES(1);
 			GetWorld()->LineTraceSingleByProfile(WallHit, Start, End, "BlockAll", Params);
 			Velocity += WallHit.Normal * WallJumpOffForce;
 		}
@@ -321,6 +733,9 @@ bool USurvivalCharacterMovementComponent::CanWalkOffLedges() const
 void USurvivalCharacterMovementComponent::UpdateCharacterStateBeforeMovement(float DeltaSeconds)
 {
 	DO_SIM_PROXY_GUARD(Super::UpdateCharacterStateBeforeMovement(DeltaSeconds));
+
+	ProbeFailures = 0;
+	bDashedThisMove = false;
 	
 	// Slide
 	if (MovementMode == MOVE_Walking && Safe_bWantsToSlide)
@@ -336,7 +751,7 @@ void USurvivalCharacterMovementComponent::UpdateCharacterStateBeforeMovement(flo
 	}
 	else if (IsFalling() && bWantsToCrouch)
 	{
-		if (TryClimb()) bWantsToCrouch = false;
+		if (TryProbe(PROBE_Climb)) bWantsToCrouch = false;
 	}
 	else if ((IsClimbing() || IsHanging()) && bWantsToCrouch)
 	{
@@ -344,49 +759,65 @@ void USurvivalCharacterMovementComponent::UpdateCharacterStateBeforeMovement(flo
 		bWantsToCrouch = false;
 	}
 
-	// Prone
-	if (Safe_bWantsToProne) 
+	// Prone, when pressed or once crouch has been held for ProneEnterHoldDuration of move time
+	bool bEnterProne = Safe_bWantsToProne;
+	if (Safe_bCrouchHeld)
 	{
-		if (CanProne())
-		{
-			SetMovementMode(MOVE_Custom, CMOVE_Prone);
-			if (!CharacterOwner->HasAuthority()) Server_EnterProne();
-		}
-		Safe_bWantsToProne = false;
+		const float PrevCrouchHoldTime = Safe_CrouchHoldTime;
+		Safe_CrouchHoldTime += DeltaSeconds;
+		bEnterProne |= PrevCrouchHoldTime < ProneEnterHoldDuration && Safe_CrouchHoldTime >= ProneEnterHoldDuration;
 	}
+	else
+	{
+		Safe_CrouchHoldTime = 0.f;
+	}
+	if (bEnterProne && !IsProne() && CanProne())
+	{
+		SetMovementMode(MOVE_Custom, CMOVE_Prone);
+	}
+	Safe_bWantsToProne = false;
 	if (IsCustomMovementMode(CMOVE_Prone) && !bWantsToCrouch)
 	{
 		SetMovementMode(MOVE_Walking);
 	}
 
-	// Dash
-	bool bAuthProxy = CharacterOwner->HasAuthority() && !CharacterOwner->IsLocallyControlled();
+	// Dash, held through the cooldown and performed as soon as it runs out
+	Safe_DashCooldownLeft = FMath::Max(Safe_DashCooldownLeft - DeltaSeconds, 0.f);
 	if (Safe_bWantsToDash && CanDash())
 	{
-		if (!bAuthProxy || GetWorld()->GetTimeSeconds() - DashStartTime > AuthDashCooldownDuration)
+		if (Safe_DashCooldownLeft <= 0.f)
 		{
 			PerformDash();
 			Safe_bWantsToDash = false;
-			Proxy_bDash = !Proxy_bDash;
+			if (IsServer()) PendingCosmeticEvents |= COSMETIC_Dash;
 		}
-		else
+		else if (bClientDashed && CharacterOwner->HasAuthority() && !CharacterOwner->IsLocallyControlled())
 		{
-			UE_LOG(LogTemp, Warning, TEXT("Client tried to cheat"))
+			ServerValidationTelemetry.RejectedDashes++;
 		}
 	}
+	bClientDashed = false;
 
 	// Try Mantle
-	if (ZippyCharacterOwner->bPressedZippyJump)
+	if (ZippyCharacterOwner->bPressedZippyJump && Safe_Transition != ESurvivalTransition::None)
+	{
+		QueueTransition(Safe_Transition == ESurvivalTransition::Hang ? ESurvivalTransition::Climb : ESurvivalTransition::Hang);
+		ZippyCharacterOwner->StopJumping();
+		ConsumeBufferedPress(INPUT_Jump);
+	}
+	else if (ZippyCharacterOwner->bPressedZippyJump)
 	{
 		SLOG("Trying jump")
-		if (TryMantle())
+		if (TryProbe(PROBE_Mantle))
 		{
 			ZippyCharacterOwner->StopJumping();		
+			ConsumeBufferedPress(INPUT_Jump);
 		}
-		else if (TryHang())
+		else if (TryProbe(PROBE_Hang))
 		{
 
 			ZippyCharacterOwner->StopJumping();		
+			ConsumeBufferedPress(INPUT_Jump);
 		}
 		else
 		{
@@ -394,6 +825,7 @@ void USurvivalCharacterMovementComponent::UpdateCharacterStateBeforeMovement(flo
 			ZippyCharacterOwner->bPressedZippyJump = false;
 			CharacterOwner->bPressedJump = true;
 			CharacterOwner->CheckJumpInput(DeltaSeconds);
+			if (CharacterOwner->bWasJumping) ConsumeBufferedPress(INPUT_Jump);
 			bOrientRotationToMovement = true;
 
 		}
@@ -404,39 +836,17 @@ void USurvivalCharacterMovementComponent::UpdateCharacterStateBeforeMovement(flo
 	if (Safe_bTransitionFinished)
 	{
 		SLOG("Transition Finished")
-		UE_LOG(LogTemp, Warning, TEXT("FINISHED RM"))
-
-		if (TransitionName == "Mantle")
-		{
-			if (IsValid(TransitionQueuedMontage))
-			{
-				SetMovementMode(MOVE_Flying);
-				CharacterOwner->PlayAnimMontage(TransitionQueuedMontage, TransitionQueuedMontageSpeed);
-				TransitionQueuedMontageSpeed = 0.f;
-				TransitionQueuedMontage = nullptr;
-			}
-			else
-			{
-				SetMovementMode(MOVE_Walking);
-			}
-		}
-		else if (TransitionName == "Hang")
-		{
-			SetMovementMode(MOVE_Custom, CMOVE_Hang);
-			Velocity = FVector::ZeroVector;
-		}
-
-		TransitionName = "";
-		Safe_bTransitionFinished = false;
+		FinishTransition();
 	}
 
 
 	// Wall Run
 	if (IsFalling())
 	{
-		TryWallRun();
+		TryProbe(PROBE_WallRun);
 	}
 
+	bReplayProbeDecisions = false;
 
 	Super::UpdateCharacterStateBeforeMovement(DeltaSeconds);
 }
@@ -451,95 +861,376 @@ void USurvivalCharacterMovementComponent::UpdateCharacterStateAfterMovement(floa
 		SetMovementMode(MOVE_Walking);
 	}
 
-	if (GetRootMotionSourceByID(TransitionRMS_ID) && GetRootMotionSourceByID(TransitionRMS_ID)->Status.HasFlag(ERootMotionSourceStatusFlags::Finished))
+	if (TransitionRMS_ID != (uint16)ERootMotionSourceID::Invalid)
 	{
-		RemoveRootMotionSourceByID(TransitionRMS_ID);
-		Safe_bTransitionFinished = true;
+		const TSharedPtr<FRootMotionSource> Source = GetRootMotionSourceByID(TransitionRMS_ID);
+		if (Source.IsValid() && Source->Status.HasFlag(ERootMotionSourceStatusFlags::Finished))
+		{
+			RemoveRootMotionSourceByID(TransitionRMS_ID);
+			TransitionRMS_ID = (uint16)ERootMotionSourceID::Invalid;
+			Safe_bTransitionFinished = true;
+		}
 	}
 
 	
 	Safe_bHadAnimRootMotion = HasAnimRootMotion();
+
+	if (IsServer()) Proxy_bWallRunIsRight = Safe_bWallRunIsRight;
 }
 
 void USurvivalCharacterMovementComponent::PhysCustom(float deltaTime, int32 Iterations)
 {
 	Super::PhysCustom(deltaTime, Iterations);
 
-	switch (CustomMovementMode)
+	if (IsInFixedStepMode())
 	{
-	case CMOVE_Slide:
-		PhysSlide(deltaTime, Iterations);
-		break;
-	case CMOVE_Prone:
-		PhysProne(deltaTime, Iterations);
-		break;
-	case CMOVE_WallRun:
-		PhysWallRun(deltaTime, Iterations);
-		break;
-	case CMOVE_Hang:
-		break;
-	case CMOVE_Climb:
-		PhysClimb(deltaTime, Iterations);
-		break;
-	default:
-		UE_LOG(LogTemp, Fatal, TEXT("Invalid Movement Mode"))
+		PhysFixedStep(deltaTime, Iterations);
+		return;
 	}
-}
-void USurvivalCharacterMovementComponent::OnMovementUpdated(float DeltaSeconds, const FVector& OldLocation, const FVector& OldVelocity)
-{
-	Super::OnMovementUpdated(DeltaSeconds, OldLocation, OldVelocity);
-	
-	Safe_bPrevWantsToCrouch = bWantsToCrouch;
+
+	PhysSurvivalCustom(deltaTime, Iterations);
 }
 
-// Movement Event
-void USurvivalCharacterMovementComponent::OnMovementModeChanged(EMovementMode PreviousMovementMode, uint8 PreviousCustomMode)
+void USurvivalCharacterMovementComponent::PhysSurvivalCustom(float deltaTime, int32 Iterations)
 {
-	Super::OnMovementModeChanged(PreviousMovementMode, PreviousCustomMode);
-
-	if (PreviousMovementMode == MOVE_Custom && PreviousCustomMode == CMOVE_Slide) ExitSlide();
-	if (PreviousMovementMode == MOVE_Custom && PreviousCustomMode == CMOVE_Prone) ExitProne();
-	
-	if (IsCustomMovementMode(CMOVE_Slide)) EnterSlide(PreviousMovementMode, static_cast<ECustomMovementMode>(PreviousCustomMode));
-	if (IsCustomMovementMode(CMOVE_Prone)) EnterProne(PreviousMovementMode, static_cast<ECustomMovementMode>(PreviousCustomMode));
-
-	if (IsFalling())
-	{
-		bOrientRotationToMovement = true;
-	}
-
-	if (IsWallRunning() && GetOwnerRole() == ROLE_SimulatedProxy)
+	const FModeDescriptor& Mode = GetModeDescriptor(CustomMovementMode);
+	if (Mode.Phys)
 	{
-		FVector Start = UpdatedComponent->GetComponentLocation();
-		FVector End = Start + UpdatedComponent->GetRightVector() * CapR() * 2;
-		auto Params = ZippyCharacterOwner->GetIgnoreCharacterParams();
-		FHitResult WallHit;
-		Safe_bWallRunIsRight = GetWorld()->LineTraceSingleByProfile(WallHit, Start, End, "BlockAll", Params);
+		(this->*Mode.Phys)(deltaTime, Iterations);
 	}
 }
 
+const USurvivalCharacterMovementComponent::FModeDescriptor USurvivalCharacterMovementComponent::ModeDescriptors[CMOVE_MAX] =
+{
+	// CMOVE_None
+	{ nullptr, nullptr, nullptr, nullptr, nullptr, false },
+	// CMOVE_Slide
+	{
+		&USurvivalCharacterMovementComponent::MaxSlideSpeed, &USurvivalCharacterMovementComponent::BrakingDecelerationSliding,
+		&USurvivalCharacterMovementComponent::PhysSlide, &USurvivalCharacterMovementComponent::EnterSlide, &USurvivalCharacterMovementComponent::ExitSlide, true
+	},
+	// CMOVE_Prone
+	{
+		&USurvivalCharacterMovementComponent::MaxProneSpeed, &USurvivalCharacterMovementComponent::BrakingDecelerationProning,
+		&USurvivalCharacterMovementComponent::PhysProne, &USurvivalCharacterMovementComponent::EnterProne, &USurvivalCharacterMovementComponent::ExitProne, true
+	},
+	// CMOVE_WallRun
+	{
+		&USurvivalCharacterMovementComponent::MaxWallRunSpeed, nullptr,
+		&USurvivalCharacterMovementComponent::PhysWallRun, nullptr, nullptr, true
+	},
+	// CMOVE_Hang
+	{ nullptr, nullptr, nullptr, nullptr, nullptr, false },
+	// CMOVE_Climb
+	{
+		&USurvivalCharacterMovementComponent::MaxClimbSpeed, &USurvivalCharacterMovementComponent::BrakingDecelerationClimbing,
+		&USurvivalCharacterMovementComponent::PhysClimb, nullptr, nullptr, true
+	},
+};
+
+const USurvivalCharacterMovementComponent::FModeDescriptor& USurvivalCharacterMovementComponent::GetModeDescriptor(uint8 CustomMode)
+{
+	if (!ensureMsgf(CustomMode < CMOVE_MAX, TEXT("Invalid custom movement mode %d"), CustomMode))
+	{
+		return ModeDescriptors[CMOVE_None];
+	}
+	return ModeDescriptors[CustomMode];
+}
+
+void USurvivalCharacterMovementComponent::PhysFixedStep(float deltaTime, int32 Iterations)
+{
+	const uint8 StepMode = CustomMovementMode;
+	FixedStepRemainder += deltaTime;
+
+	int32 Steps = 0;
+	while (FixedStepRemainder >= FixedStepTime && Steps < MaxSimulationIterations)
+	{
+		Steps++;
+		FixedStepRemainder -= FixedStepTime;
+		FixedStepPrevLocation = UpdatedComponent->GetComponentLocation();
+
+		// Read before stepping, leaving the mode resets the accumulator
+		const float Leftover = FixedStepRemainder;
+		PhysSurvivalCustom(FixedStepTime, Iterations);
+
+		if (!IsCustomMovementMode(StepMode))
+		{
+			if (Leftover >= MIN_TICK_TIME)
+			{
+				StartNewPhysics(Leftover, Iterations + 1);
+			}
+			return;
+		}
+	}
+
+	// Drop time past the step cap the same way on both ends instead of carrying a growing backlog
+	FixedStepRemainder = FMath::Min(FixedStepRemainder, FixedStepTime);
+}
+
+bool USurvivalCharacterMovementComponent::IsInFixedStepMode() const
+{
+	return bUseFixedStepCustomModes && FixedStepTime > 0.f && MovementMode == MOVE_Custom && GetModeDescriptor(CustomMovementMode).bFixedStep;
+}
+
+void USurvivalCharacterMovementComponent::UpdateFixedStepVisuals()
+{
+	if (!CharacterOwner || !CharacterOwner->GetMesh()) return;
+
+	if (IsInFixedStepMode() && CharacterOwner->IsLocallyControlled())
+	{
+		// The capsule lags up to one step behind real time, so place the mesh along the last step by the unsimulated fraction
+		const float Alpha = FMath::Clamp(FixedStepRemainder / FixedStepTime, 0.f, 1.f);
+		const FVector Offset = (FixedStepPrevLocation - UpdatedComponent->GetComponentLocation()) * (1.f - Alpha);
+		CharacterOwner->GetMesh()->SetRelativeLocation(CharacterOwner->GetBaseTranslationOffset() + UpdatedComponent->GetComponentQuat().UnrotateVector(Offset));
+		bFixedStepMeshOffset = true;
+	}
+	else if (bFixedStepMeshOffset)
+	{
+		CharacterOwner->GetMesh()->SetRelativeLocation(CharacterOwner->GetBaseTranslationOffset());
+		bFixedStepMeshOffset = false;
+	}
+}
+void USurvivalCharacterMovementComponent::OnMovementUpdated(float DeltaSeconds, const FVector& OldLocation, const FVector& OldVelocity)
+{
+	Super::OnMovementUpdated(DeltaSeconds, OldLocation, OldVelocity);
+	
+	Safe_bPrevWantsToCrouch = bWantsToCrouch;
+}
+
+// Movement Event
+void USurvivalCharacterMovementComponent::OnMovementModeChanged(EMovementMode PreviousMovementMode, uint8 PreviousCustomMode)
+{
+	Super::OnMovementModeChanged(PreviousMovementMode, PreviousCustomMode);
+
+	InvalidateSurfaceContacts();
+
+	FixedStepRemainder = 0.f;
+	FixedStepPrevLocation = UpdatedComponent->GetComponentLocation();
+
+	if (PreviousMovementMode == MOVE_Custom)
+	{
+		const FModeDescriptor& PreviousMode = GetModeDescriptor(PreviousCustomMode);
+		if (PreviousMode.Exit) (this->*PreviousMode.Exit)();
+	}
+	
+	if (MovementMode == MOVE_Custom)
+	{
+		const FModeDescriptor& Mode = GetModeDescriptor(CustomMovementMode);
+		if (Mode.Enter) (this->*Mode.Enter)(PreviousMovementMode, static_cast<ECustomMovementMode>(PreviousCustomMode));
+	}
+
+	if (IsFalling())
+	{
+		bOrientRotationToMovement = true;
+	}
+
+	if (IsWallRunning() && GetOwnerRole() == ROLE_SimulatedProxy)
+	{
+		// The replicated side is the only writer on proxies, it may have arrived before the mode did
+		Safe_bWallRunIsRight = Proxy_bWallRunIsRight;
+	}
+}
+
+void USurvivalCharacterMovementComponent::SimulateMovement(float DeltaTime)
+{
+	if (!bProxyLowDetail)
+	{
+		Super::SimulateMovement(DeltaTime);
+		return;
+	}
+
+	if (bNetworkUpdateReceived)
+	{
+		bNetworkUpdateReceived = false;
+		if (bNetworkMovementModeChanged)
+		{
+			ApplyNetworkMovementMode(CharacterOwner->GetReplicatedMovementMode());
+			bNetworkMovementModeChanged = false;
+		}
+	}
+
+	UpdateComponentVelocity();
+	LastUpdateLocation = UpdatedComponent->GetComponentLocation();
+	LastUpdateRotation = UpdatedComponent->GetComponentQuat();
+	LastUpdateVelocity = Velocity;
+}
+
+void USurvivalCharacterMovementComponent::PerformMovement(float DeltaTime)
+{
+	// Contacts and probes kept from earlier moves depend on the path taken to get here, which a replay or the server does not share
+	if (CharacterOwner && IsNetworkPredicted())
+	{
+		InvalidateSurfaceContacts();
+		InvalidateProbeBatch();
+	}
+
+#if SURVIVAL_MOVEMENT_STATS
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	Super::PerformMovement(DeltaTime);
+	SurvivalMovementStats::CountPerformMovement(FPlatformTime::Cycles64() - StartCycles);
+#else
+	Super::PerformMovement(DeltaTime);
+#endif
+}
+
+bool USurvivalCharacterMovementComponent::ClientUpdatePositionAfterServerUpdate()
+{
+#if SURVIVAL_MOVEMENT_STATS
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	const bool bResult = Super::ClientUpdatePositionAfterServerUpdate();
+	if (bResult) SurvivalMovementStats::CountReplay(FPlatformTime::Cycles64() - StartCycles);
+	return bResult;
+#else
+	return Super::ClientUpdatePositionAfterServerUpdate();
+#endif
+}
+
 bool USurvivalCharacterMovementComponent::ServerCheckClientError(float ClientTimeStamp, float DeltaTime,
 	const FVector& Accel, const FVector& ClientWorldLocation, const FVector& RelativeClientLocation,
 	UPrimitiveComponent* ClientMovementBase, FName ClientBaseBoneName, uint8 ClientMovementMode)
 {
+	float LocationError = 0.f;
 	if (GetCurrentNetworkMoveData()->NetworkMoveType == FCharacterNetworkMoveData::ENetworkMoveType::NewMove)
 	{
-		float LocationError = FVector::Dist(UpdatedComponent->GetComponentLocation(), ClientWorldLocation);
-		GEngine->AddOnScreenDebugMessage(6, 100.f, FColor::Yellow, FString::Printf(TEXT("Loc: %s"), *ClientWorldLocation.ToString()));
+		LocationError = FVector::Dist(UpdatedComponent->GetComponentLocation(), ClientWorldLocation);
 		AccumulatedClientLocationError += LocationError * DeltaTime;
 	}
 
+	bool bNeedsCorrection = Super::ServerCheckClientError(ClientTimeStamp, DeltaTime, Accel, ClientWorldLocation, RelativeClientLocation,
+	                                                      ClientMovementBase,
+	                                                      ClientBaseBoneName, ClientMovementMode);
 
-	
-	return Super::ServerCheckClientError(ClientTimeStamp, DeltaTime, Accel, ClientWorldLocation, RelativeClientLocation,
-	                                     ClientMovementBase,
-	                                     ClientBaseBoneName, ClientMovementMode);
+	ServerMovesCheckedCount++;
+	const int32 ForcedCorrectionInterval = USurvivalMovementBenchmarkSubsystem::GetForcedCorrectionInterval();
+	if (ForcedCorrectionInterval > 0 && ServerMovesCheckedCount % ForcedCorrectionInterval == 0)
+	{
+		bNeedsCorrection = true;
+	}
+
+	// The client is snapped back to our position, so it starts over with a full budget
+	if (bNeedsCorrection)
+	{
+		ResolveServerPositionErrorBudget() = ServerPositionErrorBudget;
+		ServerValidationTelemetry.CorrectionsSent++;
+	}
+
+	ServerValidationTelemetry.MovesChecked++;
+	ServerValidationTelemetry.MaxLocationError = FMath::Max(ServerValidationTelemetry.MaxLocationError, LocationError);
+	ReportServerValidationTelemetry();
+
+#if SURVIVAL_MOVEMENT_STATS
+	SurvivalMovementStats::CountServerMoveChecked(bNeedsCorrection, LocationError);
+#endif
+
+	return bNeedsCorrection;
+}
+
+bool USurvivalCharacterMovementComponent::ServerExceedsAllowablePositionError(float ClientTimeStamp, float DeltaTime,
+	const FVector& Accel, const FVector& ClientWorldLocation, const FVector& RelativeClientLocation,
+	UPrimitiveComponent* ClientMovementBase, FName ClientBaseBoneName, uint8 ClientMovementMode)
+{
+	// Mode disagreements are handled by the default check as large corrections
+	if (PackNetworkMovementMode() != ClientMovementMode)
+	{
+		return Super::ServerExceedsAllowablePositionError(ClientTimeStamp, DeltaTime, Accel, ClientWorldLocation, RelativeClientLocation,
+		                                                  ClientMovementBase, ClientBaseBoneName, ClientMovementMode);
+	}
+
+	const float LocationError = FVector::Dist(UpdatedComponent->GetComponentLocation(), ClientWorldLocation);
+	const float Tolerance = GetServerPositionTolerance();
+	float& BudgetLeft = ResolveServerPositionErrorBudget();
+
+	if (LocationError <= Tolerance)
+	{
+		BudgetLeft = FMath::Min(BudgetLeft + ServerPositionErrorBudgetRecoveryRate * DeltaTime, ServerPositionErrorBudget);
+		return false;
+	}
+
+	// Spend the budget on small errors, the server position stays authoritative and the error is checked again next move
+	const float BudgetCost = (LocationError - Tolerance) * DeltaTime;
+	if (LocationError <= ServerMaxPositionTolerance && BudgetCost <= BudgetLeft)
+	{
+		BudgetLeft -= BudgetCost;
+		ServerValidationTelemetry.ErrorsAbsorbed++;
+		return false;
+	}
+
+	bNetworkLargeClientCorrection |= LocationError > NetworkLargeClientCorrectionDistance;
+	return true;
+}
+
+float USurvivalCharacterMovementComponent::GetServerPositionTolerance() const
+{
+	float Tolerance = 0.f;
+	if (MovementMode == MOVE_Custom)
+	{
+		switch (CustomMovementMode)
+		{
+		case CMOVE_Slide:
+			Tolerance = ServerSlidePositionTolerance;
+			break;
+		case CMOVE_Prone:
+			Tolerance = ServerPronePositionTolerance;
+			break;
+		case CMOVE_WallRun:
+			Tolerance = ServerWallRunPositionTolerance;
+			break;
+		case CMOVE_Hang:
+		case CMOVE_Climb:
+			Tolerance = ServerClimbPositionTolerance;
+			break;
+		default:
+			break;
+		}
+	}
+
+	return Tolerance > 0.f ? Tolerance : FMath::Sqrt(GetDefault<AGameNetworkManager>()->MAXPOSITIONERRORSQUARED);
+}
+
+float& USurvivalCharacterMovementComponent::ResolveServerPositionErrorBudget()
+{
+	// Keyed on the connection so a client cannot refill its budget by respawning into a new pawn
+	const UNetConnection* Connection = CharacterOwner ? CharacterOwner->GetNetConnection() : nullptr;
+	const UGameInstance* GameInstance = GetWorld()->GetGameInstance();
+	USurvivalMovementValidationSubsystem* Validation = Connection && GameInstance ? GameInstance->GetSubsystem<USurvivalMovementValidationSubsystem>() : nullptr;
+	return Validation ? Validation->GetPositionErrorBudget(Connection, ServerPositionErrorBudget) : ServerPositionErrorBudgetLeft;
+}
+
+float USurvivalCharacterMovementComponent::GetServerPositionErrorBudgetLeft() const
+{
+	const UNetConnection* Connection = CharacterOwner ? CharacterOwner->GetNetConnection() : nullptr;
+	const UGameInstance* GameInstance = GetWorld()->GetGameInstance();
+	const USurvivalMovementValidationSubsystem* Validation = Connection && GameInstance ? GameInstance->GetSubsystem<USurvivalMovementValidationSubsystem>() : nullptr;
+	if (!Validation) return ServerPositionErrorBudgetLeft;
+
+	const float* BudgetLeft = Validation->FindPositionErrorBudget(Connection);
+	return BudgetLeft ? *BudgetLeft : ServerPositionErrorBudget;
+}
+
+void USurvivalCharacterMovementComponent::ReportServerValidationTelemetry()
+{
+	if (ServerValidationReportInterval <= 0.f) return;
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	if (Now - ServerValidationTelemetry.LastReportTime < ServerValidationReportInterval) return;
+
+	if (ServerValidationTelemetry.CorrectionsSent > 0 || ServerValidationTelemetry.RejectedDashes > 0)
+	{
+		UE_LOG(LogSurvivalCharacterMovement, Log, TEXT("%s: %d moves checked, %d corrections, %d errors absorbed, %d state mismatches, %d rejected dashes, max error %.1f cm, budget left %.2f"),
+			*GetNameSafe(CharacterOwner), ServerValidationTelemetry.MovesChecked, ServerValidationTelemetry.CorrectionsSent,
+			ServerValidationTelemetry.ErrorsAbsorbed, ServerValidationTelemetry.StateMismatches, ServerValidationTelemetry.RejectedDashes,
+			ServerValidationTelemetry.MaxLocationError, GetServerPositionErrorBudgetLeft());
+	}
 
+	ServerValidationTelemetry = FServerValidationTelemetry();
+	ServerValidationTelemetry.LastReportTime = Now;
 }
 
 
 void USurvivalCharacterMovementComponent::CallServerMovePacked(const FSavedMove_Character* NewMove, const FSavedMove_Character* PendingMove, const FSavedMove_Character* OldMove)
 {
+	SURVIVAL_SCOPE_CYCLE_COUNTER(CallServerMovePacked);
+
 	// Get storage container we'll be using and fill it with movement data
 	FCharacterNetworkMoveDataContainer& MoveDataContainer = GetNetworkMoveDataContainer();
 	MoveDataContainer.ClientFillNetworkMoveData(NewMove, PendingMove, OldMove);
@@ -548,9 +1239,9 @@ void USurvivalCharacterMovementComponent::CallServerMovePacked(const FSavedMove_
 	FBitWriterMark BitWriterReset;
 	BitWriterReset.Pop(SurvivalServerMoveBitWriter);
 
-	// 'static' to avoid reallocation each invocation
-	static FCharacterServerMovePackedBits PackedBits;
-	
+	// Kept on the component to avoid reallocation each invocation without sharing it between components or worlds
+	FCharacterServerMovePackedBits& PackedBits = SurvivalServerMovePackedBits;
+
 	{
 		const UNetConnection* NetConnection = CharacterOwner->GetNetConnection();
 		// Extract the net package map used for serializing object references.
@@ -577,6 +1268,9 @@ void USurvivalCharacterMovementComponent::CallServerMovePacked(const FSavedMove_
 	FMemory::Memcpy(PackedBits.DataBits.GetData(), SurvivalServerMoveBitWriter.GetData(), SurvivalServerMoveBitWriter.GetNumBytes());
 
 	TotalBitsSent += PackedBits.DataBits.Num();
+#if SURVIVAL_MOVEMENT_STATS
+	SurvivalMovementStats::CountServerMoveBits(PackedBits.DataBits.Num());
+#endif
 
 	// Send bits to server!
 	ServerMovePacked_ClientSend(PackedBits);
@@ -586,50 +1280,18 @@ void USurvivalCharacterMovementComponent::CallServerMovePacked(const FSavedMove_
 
 #pragma endregion
 
-#pragma region Slide
-
-void USurvivalCharacterMovementComponent::EnterSlide(EMovementMode PrevMode, ECustomMovementMode PrevCustomMode)
-{
-	bWantsToCrouch = true;
-	bOrientRotationToMovement = false;
-
-	// Should prevent the spamming of slide to exploit the slide speed initial impulse.
-	if (Velocity.Size2D() < MaxSlideImpulseSpeed + SERVER_TOLERANCE)
-	{
-		Velocity += Velocity.GetSafeNormal2D() * SlideEnterImpulse;
-	}
-
-	FindFloor(UpdatedComponent->GetComponentLocation(), CurrentFloor, true, nullptr);
-}
-void USurvivalCharacterMovementComponent::ExitSlide()
-{
-	Safe_bWantsToSlide = false;
-	bWantsToCrouch = false;
-	bOrientRotationToMovement = true;
-}
-bool USurvivalCharacterMovementComponent::CanSlide() const
-{
-	FVector Start = UpdatedComponent->GetComponentLocation();
-	FVector End = Start + CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleHalfHeight() * 2.5f * FVector::DownVector;
-	FName ProfileName = TEXT("BlockAll");
-	bool bValidSurface = GetWorld()->LineTraceTestByProfile(Start, End, ProfileName, ZippyCharacterOwner->GetIgnoreCharacterParams());
-	bool bEnoughSpeed = Velocity.SizeSquared() > pow(MinSlideSpeed, 2);
-	
-	return bValidSurface && bEnoughSpeed;
-}
+#pragma region Ground
 
-void USurvivalCharacterMovementComponent::PhysSlide(float deltaTime, int32 Iterations)
+template<typename TGroundModel>
+void USurvivalCharacterMovementComponent::PhysGround(float deltaTime, int32 Iterations)
 {
 	if (deltaTime < MIN_TICK_TIME)
 	{
 		return;
 	}
 
-	
-	if (!CanSlide())
+	if (!TGroundModel::CanStart(*this, deltaTime, Iterations))
 	{
-		SetMovementMode(MOVE_Walking);
-		StartNewPhysics(deltaTime, Iterations);
 		return;
 	}
 
@@ -643,7 +1305,7 @@ void USurvivalCharacterMovementComponent::PhysSlide(float deltaTime, int32 Itera
 	{
 		Iterations++;
 		bJustTeleported = false;
-		const float timeTick = GetSimulationTimeStep(remainingTime, Iterations);
+		const float timeTick = GetSurvivalSimulationTimeStep(remainingTime, Iterations);
 		remainingTime -= timeTick;
 
 		// Save current values
@@ -656,21 +1318,15 @@ void USurvivalCharacterMovementComponent::PhysSlide(float deltaTime, int32 Itera
 		MaintainHorizontalGroundVelocity();
 		const FVector OldVelocity = Velocity;
 
-		FVector SlopeForce = CurrentFloor.HitResult.Normal;
-		SlopeForce.Z = 0.f;
-		Velocity += SlopeForce * SlideGravityForce * deltaTime;
-		
-		Acceleration = Acceleration.ProjectOnTo(UpdatedComponent->GetRightVector().GetSafeNormal2D());
-
-		// Apply acceleration
-		CalcVelocity(timeTick, GroundFriction * SlideFrictionFactor, false, GetMaxBrakingDeceleration());
+		// Apply the mode's forces, friction and acceleration
+		TGroundModel::ApplyForces(*this, deltaTime, timeTick);
 		
 		// Compute move parameters
 		const FVector MoveVelocity = Velocity;
-		const FVector Delta = timeTick * MoveVelocity;
+		const FVector Delta = timeTick * MoveVelocity; // dx = v * dt
 		const bool bZeroDelta = Delta.IsNearlyZero();
 		FStepDownResult StepDownResult;
-		bool bFloorWalkable = CurrentFloor.IsWalkableFloor();
+		const bool bFloorWalkable = CurrentFloor.IsWalkableFloor();
 
 		if (bZeroDelta)
 		{
@@ -701,17 +1357,16 @@ void USurvivalCharacterMovementComponent::PhysSlide(float deltaTime, int32 Itera
 		}
 
 		// Update floor.
-		// StepUp might have already done it for us.
+		// StepUp might have already done it for us, and a clean move along a static floor face can carry it over.
 		if (StepDownResult.bComputedFloor)
 		{
 			CurrentFloor = StepDownResult.FloorResult;
 		}
-		else
+		else if (bZeroDelta || !TryReuseAdjacentFloor(OldFloor, OldLocation, Delta))
 		{
 			FindFloor(UpdatedComponent->GetComponentLocation(), CurrentFloor, bZeroDelta, nullptr);
 		}
 
-		// @TODO: Should just stop the character dead in its tracks if we cant slide of the ledge?
 		// Checking for ledges to avoid if we cant walk off them.
 		if (!CanWalkOffLedges() && !CurrentFloor.IsWalkableFloor())
 		{
@@ -727,7 +1382,7 @@ void USurvivalCharacterMovementComponent::PhysSlide(float deltaTime, int32 Itera
 				bTriedLedgeMove = true;
 
 				// Try new movement direction
-				Velocity = NewDelta / timeTick;
+				Velocity = NewDelta / timeTick; // v = dx/dt
 				remainingTime += timeTick;
 				continue;
 			}
@@ -753,15 +1408,18 @@ void USurvivalCharacterMovementComponent::PhysSlide(float deltaTime, int32 Itera
 			// Validate the floor check
 			if (CurrentFloor.IsWalkableFloor())
 			{
-				if (ShouldCatchAir(OldFloor, CurrentFloor))
+				if constexpr (TGroundModel::bCatchAir)
 				{
-					HandleWalkingOffLedge(OldFloor.HitResult.ImpactNormal, OldFloor.HitResult.Normal, OldLocation, timeTick);
-					if (IsMovingOnGround())
+					if (ShouldCatchAir(OldFloor, CurrentFloor))
 					{
-						// If still walking, then fall. If not, assume the user set a different mode they want to keep.
-						StartFalling(Iterations, remainingTime, timeTick, Delta, OldLocation);
+						HandleWalkingOffLedge(OldFloor.HitResult.ImpactNormal, OldFloor.HitResult.Normal, OldLocation, timeTick);
+						if (IsMovingOnGround())
+						{
+							// If still walking, then fall. If not, assume the user set a different mode they want to keep.
+							StartFalling(Iterations, remainingTime, timeTick, Delta, OldLocation);
+						}
+						return;
 					}
-					return;
 				}
 
 				AdjustFloorHeight();
@@ -798,13 +1456,13 @@ void USurvivalCharacterMovementComponent::PhysSlide(float deltaTime, int32 Itera
 		}
 		
 		// Allow overlap events and such to change physics state and velocity
-		if (IsMovingOnGround() && bFloorWalkable)
+		if (IsMovingOnGround() && (bFloorWalkable || !TGroundModel::bVelocityFromWalkableFloorOnly))
 		{
 			// Make velocity reflect actual move
-			if(!bJustTeleported && !HasAnimRootMotion() && !CurrentRootMotion.HasOverrideVelocity() && timeTick >= MIN_TICK_TIME)
+			if (!bJustTeleported && !HasAnimRootMotion() && !CurrentRootMotion.HasOverrideVelocity() && timeTick >= MIN_TICK_TIME)
 			{
 				// TODO-RootMotionSource: Allow this to happen during partial override Velocity, but only set allowed axes?
-				Velocity = (UpdatedComponent->GetComponentLocation() - OldLocation) / timeTick;
+				Velocity = (UpdatedComponent->GetComponentLocation() - OldLocation) / timeTick; // v = dx / dt
 				MaintainHorizontalGroundVelocity();
 			}
 		}
@@ -817,23 +1475,147 @@ void USurvivalCharacterMovementComponent::PhysSlide(float deltaTime, int32 Itera
 		}
 	}
 
+	TGroundModel::Finish(*this);
+}
+
+bool USurvivalCharacterMovementComponent::TryReuseAdjacentFloor(const FFindFloorResult& OldFloor, const FVector& OldLocation, const FVector& Delta)
+{
+	if (!bReuseAdjacentFloor || bForceNextFloorCheck || bJustTeleported) return false;
+	if (!OldFloor.IsWalkableFloor() || OldFloor.bLineTrace || OldFloor.HitResult.bStartPenetrating) return false;
+
+	const FHitResult& OldHit = OldFloor.HitResult;
+	const UPrimitiveComponent* FloorComponent = OldHit.GetComponent();
+	if (!FloorComponent || FloorComponent->Mobility != EComponentMobility::Static) return false;
+
+	// The capsule has to rest on a face, not an edge, for the face's plane to be the floor
+	const FVector FloorNormal = OldHit.ImpactNormal;
+	if ((OldHit.Normal | FloorNormal) < ADJACENT_FLOOR_MIN_NORMAL_DOT) return false;
+
+	// A blocked move or a step changed what is under the capsule, move along floor keeps the horizontal delta otherwise
+	const FVector Location = UpdatedComponent->GetComponentLocation();
+	if (FVector::DistSquared2D(Location - OldLocation, Delta) > FMath::Square(ADJACENT_FLOOR_MOVE_TOLERANCE)) return false;
+
+	// Trace down from the point of the capsule that touches the plane, it hits the same face at the floor distance
+	const FVector ContactPoint = Location + FVector::DownVector * (CapHH() - CapR()) - FloorNormal * CapR();
+	const FVector Start = ContactPoint + FVector::UpVector * MAX_FLOOR_DIST;
+	const FVector End = ContactPoint + FVector::DownVector * MAX_FLOOR_DIST;
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(SurvivalAdjacentFloor), false, CharacterOwner);
+	FCollisionResponseParams ResponseParams;
+	InitCollisionParams(QueryParams, ResponseParams);
 
 	FHitResult Hit;
-	FQuat NewRotation = FRotationMatrix::MakeFromXZ(Velocity.GetSafeNormal2D(), FVector::UpVector).ToQuat();
-	SafeMoveUpdatedComponent(FVector::ZeroVector, NewRotation, false, Hit);
+	COUNT_TRACES(1);
+	if (!GetWorld()->LineTraceSingleByChannel(Hit, Start, End, UpdatedComponent->GetCollisionObjectType(), QueryParams, ResponseParams)) return false;
+	if (Hit.bStartPenetrating || Hit.GetComponent() != FloorComponent || (Hit.ImpactNormal | FloorNormal) < ADJACENT_FLOOR_MIN_NORMAL_DOT) return false;
+
+	const float FloorDist = Hit.Distance - MAX_FLOOR_DIST;
+	if (FloorDist < 0.f || FloorDist > MAX_FLOOR_DIST) return false;
+
+	// Same plane under the same capsule, so the result a floor sweep gives is the old one carried along by the move
+	const FVector SweepDelta = OldHit.TraceEnd - OldHit.TraceStart;
+	FHitResult FloorHit = OldHit;
+	FloorHit.TraceStart = Location;
+	FloorHit.TraceEnd = Location + SweepDelta;
+	FloorHit.Location = Location + FVector::DownVector * FloorDist;
+	FloorHit.ImpactPoint = Hit.ImpactPoint;
+	FloorHit.Distance = FloorDist;
+	FloorHit.Time = FloorDist / FMath::Max(SweepDelta.Size(), UE_KINDA_SMALL_NUMBER);
+
+	CurrentFloor.SetFromSweep(FloorHit, FloorDist, true);
+	return true;
 }
 
 #pragma endregion
 
-#pragma region Prone
+#pragma region Slide
+
+void USurvivalCharacterMovementComponent::EnterSlide(EMovementMode PrevMode, ECustomMovementMode PrevCustomMode)
+{
+	ConsumeBufferedPress(INPUT_Slide);
+	bWantsToCrouch = true;
+	bOrientRotationToMovement = false;
+
+	// Should prevent the spamming of slide to exploit the slide speed initial impulse.
+	if (Velocity.Size2D() < MaxSlideImpulseSpeed + SERVER_TOLERANCE)
+	{
+		Velocity += Velocity.GetSafeNormal2D() * SlideEnterImpulse;
+	}
+
+	FindFloor(UpdatedComponent->GetComponentLocation(), CurrentFloor, true, nullptr);
+}
+void USurvivalCharacterMovementComponent::ExitSlide()
+{
+	Safe_bWantsToSlide = false;
+	bWantsToCrouch = false;
+	bOrientRotationToMovement = true;
+}
+bool USurvivalCharacterMovementComponent::CanSlide() const
+{
+	bool bEnoughSpeed = Velocity.SizeSquared() > Derived.MinSlideSpeedSquared;
+	if (!bEnoughSpeed) return false;
+
+	// The floor found by the last ground move is already well inside the trace's reach
+	if (IsMovingOnGround() && CurrentFloor.IsWalkableFloor()) return true;
+
+	FVector Start = UpdatedComponent->GetComponentLocation();
+	FVector End = Start + CapHH() * 2.5f * FVector::DownVector;
+	FName ProfileName = TEXT("BlockAll");
+	COUNT_TRACES(1);
+	return GetWorld()->LineTraceTestByProfile(Start, End, ProfileName, ZippyCharacterOwner->GetIgnoreCharacterParams());
+}
+
+struct USurvivalCharacterMovementComponent::FSlideGroundModel
+{
+	// Leaving a floor that drops away mid slide launches the character instead of gluing it to the slope.
+	static constexpr bool bCatchAir = true;
+	// Landing on an unwalkable floor keeps the slide velocity instead of the velocity of the blocked move.
+	static constexpr bool bVelocityFromWalkableFloorOnly = true;
+
+	static bool CanStart(USurvivalCharacterMovementComponent& Move, float deltaTime, int32 Iterations)
+	{
+		if (!Move.CanSlide())
+		{
+			Move.SetMovementMode(MOVE_Walking);
+			Move.StartNewPhysics(deltaTime, Iterations);
+			return false;
+		}
+		return true;
+	}
+
+	static void ApplyForces(USurvivalCharacterMovementComponent& Move, float deltaTime, float timeTick)
+	{
+		FVector SlopeForce = Move.CurrentFloor.HitResult.Normal;
+		SlopeForce.Z = 0.f;
+		Move.Velocity += SlopeForce * Move.SlideGravityForce * deltaTime;
+
+		Move.Acceleration = Move.Acceleration.ProjectOnTo(Move.UpdatedComponent->GetRightVector().GetSafeNormal2D());
 
-void USurvivalCharacterMovementComponent::Server_EnterProne_Implementation()
+		Move.CalcVelocity(timeTick, Move.GroundFriction * Move.SlideFrictionFactor, false, Move.GetMaxBrakingDeceleration());
+	}
+
+	static void Finish(USurvivalCharacterMovementComponent& Move)
+	{
+		FHitResult Hit;
+		FQuat NewRotation = FRotationMatrix::MakeFromXZ(Move.Velocity.GetSafeNormal2D(), FVector::UpVector).ToQuat();
+		Move.SafeMoveUpdatedComponent(FVector::ZeroVector, NewRotation, false, Hit);
+	}
+};
+
+void USurvivalCharacterMovementComponent::PhysSlide(float deltaTime, int32 Iterations)
 {
-	Safe_bWantsToProne = true;
+	SURVIVAL_SCOPE_CYCLE_COUNTER(PhysSlide);
+
+	PhysGround<FSlideGroundModel>(deltaTime, Iterations);
 }
 
+#pragma endregion
+
+#pragma region Prone
+
 void USurvivalCharacterMovementComponent::EnterProne(EMovementMode PrevMode, ECustomMovementMode PrevCustomMode)
 {
+	ConsumeBufferedPress(INPUT_Prone);
 	bWantsToCrouch = true;
 
 	if (PrevMode == MOVE_Custom && PrevCustomMode == CMOVE_Slide)
@@ -852,202 +1634,52 @@ bool USurvivalCharacterMovementComponent::CanProne() const
 	return IsCustomMovementMode(CMOVE_Slide) || IsMovementMode(MOVE_Walking) && IsCrouching();
 }
 
-void USurvivalCharacterMovementComponent::PhysProne(float deltaTime, int32 Iterations)
+struct USurvivalCharacterMovementComponent::FProneGroundModel
 {
-	if (deltaTime < MIN_TICK_TIME)
+	// Prone crawls off ledges into a fall through CheckFall rather than catching air.
+	static constexpr bool bCatchAir = false;
+	// Velocity always follows the actual move.
+	static constexpr bool bVelocityFromWalkableFloorOnly = false;
+
+	static bool CanStart(USurvivalCharacterMovementComponent& Move, float deltaTime, int32 Iterations)
 	{
-		return;
+		ACharacter* Owner = Move.CharacterOwner;
+		if (!Owner || (!Owner->Controller && !Move.bRunPhysicsWithNoController && !Move.HasAnimRootMotion() && !Move.CurrentRootMotion.HasOverrideVelocity() && (Owner->GetLocalRole() != ROLE_SimulatedProxy)))
+		{
+			Move.Acceleration = FVector::ZeroVector;
+			Move.Velocity = FVector::ZeroVector;
+			return false;
+		}
+		return true;
 	}
 
-	if (!CharacterOwner || (!CharacterOwner->Controller && !bRunPhysicsWithNoController && !HasAnimRootMotion() && !CurrentRootMotion.HasOverrideVelocity() && (CharacterOwner->GetLocalRole() != ROLE_SimulatedProxy)))
+	static void ApplyForces(USurvivalCharacterMovementComponent& Move, float deltaTime, float timeTick)
 	{
-		Acceleration = FVector::ZeroVector;
-		Velocity = FVector::ZeroVector;
-		return;
-	}
+		Move.Acceleration.Z = 0.f;
 
-	bJustTeleported = false;
-	bool bCheckedFall = false;
-	bool bTriedLedgeMove = false;
-	float remainingTime = deltaTime;
+		Move.CalcVelocity(timeTick, Move.GroundFriction, false, Move.GetMaxBrakingDeceleration());
+	}
 
-	// Perform the move
-	while ( (remainingTime >= MIN_TICK_TIME) && (Iterations < MaxSimulationIterations) && CharacterOwner && (CharacterOwner->Controller || bRunPhysicsWithNoController || (CharacterOwner->GetLocalRole() == ROLE_SimulatedProxy)) )
+	static void Finish(USurvivalCharacterMovementComponent& Move)
 	{
-		Iterations++;
-		bJustTeleported = false;
-		const float timeTick = GetSimulationTimeStep(remainingTime, Iterations);
-		remainingTime -= timeTick;
-
-		// Save current values
-		UPrimitiveComponent * const OldBase = GetMovementBase();
-		const FVector PreviousBaseLocation = (OldBase != nullptr) ? OldBase->GetComponentLocation() : FVector::ZeroVector;
-		const FVector OldLocation = UpdatedComponent->GetComponentLocation();
-		const FFindFloorResult OldFloor = CurrentFloor;
-
-		// Ensure velocity is horizontal.
-		MaintainHorizontalGroundVelocity();
-		const FVector OldVelocity = Velocity;
-		Acceleration.Z = 0.f;
-
-		// Apply acceleration
-		CalcVelocity(timeTick, GroundFriction, false, GetMaxBrakingDeceleration());
-		
-		// Compute move parameters
-		const FVector MoveVelocity = Velocity;
-		const FVector Delta = timeTick * MoveVelocity; // dx = v * dt
-		const bool bZeroDelta = Delta.IsNearlyZero();
-		FStepDownResult StepDownResult;
-
-		if (bZeroDelta)
-		{
-			remainingTime = 0.f;
-		}
-		else
-		{
-			MoveAlongFloor(MoveVelocity, timeTick, &StepDownResult);
-
-			if (IsFalling())
-			{
-				// pawn decided to jump up
-				const float DesiredDist = Delta.Size();
-				if (DesiredDist > KINDA_SMALL_NUMBER)
-				{
-					const float ActualDist = (UpdatedComponent->GetComponentLocation() - OldLocation).Size2D();
-					remainingTime += timeTick * (1.f - FMath::Min(1.f,ActualDist/DesiredDist));
-				}
-				StartNewPhysics(remainingTime,Iterations);
-				return;
-			}
-			else if (IsSwimming()) //just entered water
-			{
-				StartSwimming(OldLocation, OldVelocity, timeTick, remainingTime, Iterations);
-				return;
-			}
-		}
-
-		// Update floor.
-		// StepUp might have already done it for us.
-		if (StepDownResult.bComputedFloor)
-		{
-			CurrentFloor = StepDownResult.FloorResult;
-		}
-		else
-		{
-			FindFloor(UpdatedComponent->GetComponentLocation(), CurrentFloor, bZeroDelta, nullptr);
-		}
-
-
-		// check for ledges here
-		const bool bCheckLedges = !CanWalkOffLedges();
-		if (bCheckLedges && !CurrentFloor.IsWalkableFloor())
-		{
-			// calculate possible alternate movement
-			const FVector GravDir = FVector(0.f,0.f,-1.f);
-			const FVector NewDelta = bTriedLedgeMove ? FVector::ZeroVector : GetLedgeMove(OldLocation, Delta, GravDir);
-			if (!NewDelta.IsZero())
-			{
-				// first revert this move
-				RevertMove(OldLocation, OldBase, PreviousBaseLocation, OldFloor, false);
-
-				// avoid repeated ledge moves if the first one fails
-				bTriedLedgeMove = true;
-
-				// Try new movement direction
-				Velocity = NewDelta/timeTick; // v = dx/dt
-				remainingTime += timeTick;
-				continue;
-			}
-			else
-			{
-				// see if it is OK to jump
-				// @todo collision : only thing that can be problem is that oldbase has world collision on
-				bool bMustJump = bZeroDelta || (OldBase == nullptr || (!OldBase->IsQueryCollisionEnabled() && MovementBaseUtility::IsDynamicBase(OldBase)));
-				if ((bMustJump || !bCheckedFall) && CheckFall(OldFloor, CurrentFloor.HitResult, Delta, OldLocation, remainingTime, timeTick, Iterations, bMustJump))
-				{
-					return;
-				}
-				bCheckedFall = true;
-
-				// revert this move
-				RevertMove(OldLocation, OldBase, PreviousBaseLocation, OldFloor, true);
-				remainingTime = 0.f;
-				break;
-			}
-		}
-		else
-		{
-			// Validate the floor check
-			if (CurrentFloor.IsWalkableFloor())
-			{
-				AdjustFloorHeight();
-				SetBase(CurrentFloor.HitResult.Component.Get(), CurrentFloor.HitResult.BoneName);
-			}
-			else if (CurrentFloor.HitResult.bStartPenetrating && remainingTime <= 0.f)
-			{
-				// The floor check failed because it started in penetration
-				// We do not want to try to move downward because the downward sweep failed, rather we'd like to try to pop out of the floor.
-				FHitResult Hit(CurrentFloor.HitResult);
-				Hit.TraceEnd = Hit.TraceStart + FVector(0.f, 0.f, MAX_FLOOR_DIST);
-				const FVector RequestedAdjustment = GetPenetrationAdjustment(Hit);
-				ResolvePenetration(RequestedAdjustment, Hit, UpdatedComponent->GetComponentQuat());
-				bForceNextFloorCheck = true;
-			}
-
-			// check if just entered water
-			if (IsSwimming())
-			{
-				StartSwimming(OldLocation, Velocity, timeTick, remainingTime, Iterations);
-				return;
-			}
-
-			// See if we need to start falling.
-			if (!CurrentFloor.IsWalkableFloor() && !CurrentFloor.HitResult.bStartPenetrating)
-			{
-				const bool bMustJump = bJustTeleported || bZeroDelta || (OldBase == nullptr || (!OldBase->IsQueryCollisionEnabled() && MovementBaseUtility::IsDynamicBase(OldBase)));
-				if ((bMustJump || !bCheckedFall) && CheckFall(OldFloor, CurrentFloor.HitResult, Delta, OldLocation, remainingTime, timeTick, Iterations, bMustJump) )
-				{
-					return;
-				}
-				bCheckedFall = true;
-			}
-		}
-		
-		// Allow overlap events and such to change physics state and velocity
-		if (IsMovingOnGround())
-		{
-			// Make velocity reflect actual move
-			if( !bJustTeleported && !HasAnimRootMotion() && !CurrentRootMotion.HasOverrideVelocity() && timeTick >= MIN_TICK_TIME)
-			{
-				// TODO-RootMotionSource: Allow this to happen during partial override Velocity, but only set allowed axes?
-				Velocity = (UpdatedComponent->GetComponentLocation() - OldLocation) / timeTick; // v = dx / dt
-				MaintainHorizontalGroundVelocity();
-			}
-		}
-
-		// If we didn't move at all this iteration then abort (since future iterations will also be stuck).
-		if (UpdatedComponent->GetComponentLocation() == OldLocation)
+		if (Move.IsMovingOnGround())
 		{
-			remainingTime = 0.f;
-			break;
+			Move.MaintainHorizontalGroundVelocity();
 		}
 	}
+};
 
-	if (IsMovingOnGround())
-	{
-		MaintainHorizontalGroundVelocity();
-	}
+void USurvivalCharacterMovementComponent::PhysProne(float deltaTime, int32 Iterations)
+{
+	SURVIVAL_SCOPE_CYCLE_COUNTER(PhysProne);
+
+	PhysGround<FProneGroundModel>(deltaTime, Iterations);
 }
 
 #pragma endregion
 
 #pragma region Dash
 
-void USurvivalCharacterMovementComponent::OnDashCooldownFinished()
-{
-	Safe_bWantsToDash = true;
-}
-
 bool USurvivalCharacterMovementComponent::CanDash() const
 {
 	return IsWalking() && !IsCrouching() || IsFalling();
@@ -1055,7 +1687,9 @@ bool USurvivalCharacterMovementComponent::CanDash() const
 
 void USurvivalCharacterMovementComponent::PerformDash()
 {
-	DashStartTime = GetWorld()->GetTimeSeconds();
+	Safe_DashCooldownLeft = DashCooldownDuration;
+	bDashedThisMove = true;
+	ConsumeBufferedPress(INPUT_Dash);
 	
 	SetMovementMode(MOVE_Flying);
 	
@@ -1070,76 +1704,55 @@ void USurvivalCharacterMovementComponent::PerformDash()
 
 bool USurvivalCharacterMovementComponent::TryMantle()
 {
+	SURVIVAL_SCOPE_CYCLE_COUNTER(TryMantle);
+
 	if (!(IsMovementMode(MOVE_Walking) && !IsCrouching()) && !IsMovementMode(MOVE_Falling)) return false;
 
-	// Helper Variables
+	// Cheapest gates first, before any trace
+	if (MantleMaxFallSpeed > 0 && IsMovementMode(MOVE_Falling) && Velocity.Z < -MantleMaxFallSpeed) return false;
+
 	FVector BaseLoc = UpdatedComponent->GetComponentLocation() + FVector::DownVector * CapHH();
 	FVector Fwd = UpdatedComponent->GetForwardVector().GetSafeNormal2D();
-	auto Params = ZippyCharacterOwner->GetIgnoreCharacterParams();
-	float MaxHeight = CapHH() * 2+ MantleReachHeight;
-	float CosMMWSA = FMath::Cos(FMath::DegreesToRadians(MantleMinWallSteepnessAngle));
-	float CosMMSA = FMath::Cos(FMath::DegreesToRadians(MantleMaxSurfaceAngle));
-	float CosMMAA = FMath::Cos(FMath::DegreesToRadians(MantleMaxAlignmentAngle));
+	float CheckDistance = FMath::Clamp(Velocity | Fwd, CapR() + 30, MantleMaxDistance);
 
-	
 SLOG("Starting Mantle Attempt")
 
-	// Check Front Face
-	FHitResult FrontHit;
-	float CheckDistance = FMath::Clamp(Velocity | Fwd, CapR() + 30, MantleMaxDistance);
-	FVector FrontStart = BaseLoc + FVector::UpVector * (MaxStepHeight - 1);
-	for (int i = 0; i < 6; i++)
+	// A search that found nothing is reused while the character has not moved, turned or changed speed much and the wall,
+	// if one was hit, has not moved. The cache depends on history and world time, which the server and a predicting client
+	// do not share, so it is only used where no other machine simulates this character's moves.
+	const bool bUseCache = MantleCacheTolerance > 0 && CharacterOwner->GetLocalRole() == ROLE_Authority && CharacterOwner->GetRemoteRole() != ROLE_AutonomousProxy;
+	const double Now = GetWorld()->GetTimeSeconds();
+	if (bUseCache
+		&& Now - MantleCache.Time <= MantleCacheLifetime
+		&& MantleCache.MovementMode == MovementMode
+		&& FVector::PointsAreNear(MantleCache.Location, BaseLoc, MantleCacheTolerance)
+		&& (MantleCache.Forward | Fwd) >= MANTLE_CACHE_MIN_FORWARD_DOT
+		&& FMath::Abs(MantleCache.CheckDistance - CheckDistance) <= MantleCacheTolerance
+		&& (!MantleCache.bHadWall || (MantleCache.WallComponent.IsValid()
+			&& MantleCache.WallComponent->GetComponentLocation().Equals(MantleCache.WallLocation))))
 	{
-		LINE(FrontStart, FrontStart + Fwd * CheckDistance, FColor::Red)
-		if (GetWorld()->LineTraceSingleByProfile(FrontHit, FrontStart, FrontStart + Fwd * CheckDistance, "BlockAll", Params)) break;
-		FrontStart += FVector::UpVector * (2.f * CapHH() - (MaxStepHeight - 1)) / 5;
+		return false;
 	}
-	if (!FrontHit.IsValidBlockingHit()) return false;
-	float CosWallSteepnessAngle = FrontHit.Normal | FVector::UpVector;
-	if (FMath::Abs(CosWallSteepnessAngle) > CosMMWSA || (Fwd | -FrontHit.Normal) < CosMMAA) return false;
 
-POINT(FrontHit.Location, FColor::Red);
-	
-	// Check Height
-	TArray<FHitResult> HeightHits;
-	FHitResult SurfaceHit;
-	FVector WallUp = FVector::VectorPlaneProject(FVector::UpVector, FrontHit.Normal).GetSafeNormal();
-	float WallCos = FVector::UpVector | FrontHit.Normal;
-	float WallSin = FMath::Sqrt(1 - WallCos * WallCos);
-	FVector TraceStart = FrontHit.Location + Fwd + WallUp * (MaxHeight - (MaxStepHeight - 1)) / WallSin;
-LINE(TraceStart, FrontHit.Location + Fwd, FColor::Orange)
-	if (!GetWorld()->LineTraceMultiByProfile(HeightHits, TraceStart, FrontHit.Location + Fwd, "BlockAll", Params)) return false;
-	for (const FHitResult& Hit : HeightHits)
+	FHitResult FrontHit, SurfaceHit;
+	float Height;
+	if (!FindMantleSurface(BaseLoc, Fwd, CheckDistance, FrontHit, SurfaceHit, Height))
 	{
-		if (Hit.IsValidBlockingHit())
+		if (bUseCache)
 		{
-			SurfaceHit = Hit;
-			break;
+			MantleCache.Time = Now;
+			MantleCache.Location = BaseLoc;
+			MantleCache.Forward = Fwd;
+			MantleCache.CheckDistance = CheckDistance;
+			MantleCache.MovementMode = MovementMode;
+			MantleCache.WallComponent = FrontHit.GetComponent();
+			MantleCache.bHadWall = MantleCache.WallComponent.IsValid();
+			MantleCache.WallLocation = MantleCache.bHadWall ? MantleCache.WallComponent->GetComponentLocation() : FVector::ZeroVector;
 		}
-	}
-	if (!SurfaceHit.IsValidBlockingHit() || (SurfaceHit.Normal | FVector::UpVector) < CosMMSA) return false;
-	float Height = (SurfaceHit.Location - BaseLoc) | FVector::UpVector;
-
-SLOG(FString::Printf(TEXT("Height: %f"), Height))
-POINT(SurfaceHit.Location, FColor::Blue);
-	
-	if (Height > MaxHeight) return false;
-	
-
-	// Check Clearance
-	float SurfaceCos = FVector::UpVector | SurfaceHit.Normal;
-	float SurfaceSin = FMath::Sqrt(1 - SurfaceCos * SurfaceCos);
-	FVector ClearCapLoc = SurfaceHit.Location + Fwd * CapR() + FVector::UpVector * (CapHH() + 1 + CapR() * 2 * SurfaceSin);
-	FCollisionShape CapShape = FCollisionShape::MakeCapsule(CapR(), CapHH());
-	if (GetWorld()->OverlapAnyTestByProfile(ClearCapLoc, FQuat::Identity, "BlockAll", CapShape, Params))
-	{
-CAPSULE(ClearCapLoc, FColor::Red)
 		return false;
 	}
-	else
-	{
-CAPSULE(ClearCapLoc, FColor::Green)
-	}
+	MantleCache.Time = -1.;
+
 	SLOG("Can Mantle")
 	
 	// Mantle Selection
@@ -1151,7 +1764,7 @@ CAPSULE(ClearCapLoc, FColor::Green)
 		bTallMantle = true;
 	else if (IsMovementMode(MOVE_Falling) && (Velocity | FVector::UpVector) < 0)
 	{
-		if (!GetWorld()->OverlapAnyTestByProfile(TallMantleTarget, FQuat::Identity, "BlockAll", CapShape, Params))
+		if (IsCapsuleClearAt(TallMantleTarget))
 			bTallMantle = true;
 	}
 	FVector TransitionTarget = bTallMantle ? TallMantleTarget : ShortMantleTarget;
@@ -1164,8 +1777,8 @@ CAPSULE(UpdatedComponent->GetComponentLocation(), FColor::Red)
 	float TransDistance = FVector::Dist(TransitionTarget, UpdatedComponent->GetComponentLocation());
 
 	TransitionQueuedMontageSpeed = FMath::GetMappedRangeValueClamped(FVector2D(-500, 750), FVector2D(.9f, 1.2f), UpSpeed);
-	TransitionRMS.Reset();
-	TransitionRMS = MakeShared<FRootMotionSource_MoveToForce>();
+	const TSharedPtr<FRootMotionSource_MoveToForce> Source = AcquireTransitionRMS();
+	TransitionRMS = Source.Get();
 	TransitionRMS->AccumulateMode = ERootMotionAccumulateMode::Override;
 	
 	TransitionRMS->Duration = FMath::Clamp(TransDistance / 500.f, .1f, .25f);
@@ -1176,23 +1789,102 @@ SLOG(FString::Printf(TEXT("Duration: %f"), TransitionRMS->Duration))
 	// Apply Transition Root Motion Source
 	Velocity = FVector::ZeroVector;
 	SetMovementMode(MOVE_Flying);
-	TransitionRMS_ID = ApplyRootMotionSource(TransitionRMS);
-	TransitionName = "Mantle";
+	TransitionRMS_ID = ApplyRootMotionSource(Source);
+	Safe_Transition = bTallMantle ? ESurvivalTransition::TallMantle : ESurvivalTransition::ShortMantle;
 
 	// Animations
 	if (bTallMantle)
 	{
-		TransitionQueuedMontage = TallMantleMontage;
 		CharacterOwner->PlayAnimMontage(TransitionTallMantleMontage, 1 / TransitionRMS->Duration);
-		if (IsServer()) Proxy_bTallMantle = !Proxy_bTallMantle;
+		if (IsServer()) PendingCosmeticEvents |= COSMETIC_TallMantle;
 	}
 	else
 	{
-		TransitionQueuedMontage = ShortMantleMontage;
 		CharacterOwner->PlayAnimMontage(TransitionShortMantleMontage, 1 / TransitionRMS->Duration);
-		if (IsServer()) Proxy_bShortMantle = !Proxy_bShortMantle;
+		if (IsServer()) PendingCosmeticEvents |= COSMETIC_ShortMantle;
+	}
+
+	return true;
+}
+
+bool USurvivalCharacterMovementComponent::FindMantleSurface(const FVector& BaseLoc, const FVector& Fwd, float CheckDistance, FHitResult& OutFrontHit, FHitResult& OutSurfaceHit, float& OutHeight)
+{
+	// Helper Variables
+	const FCollisionQueryParams& Params = ZippyCharacterOwner->GetIgnoreCharacterParams();
+	float MaxHeight = CapHH() * 2+ MantleReachHeight;
+	const float CosMMWSA = Derived.CosMantleMinWallSteepnessAngle;
+	const float CosMMSA = Derived.CosMantleMaxSurfaceAngle;
+	const float CosMMAA = Derived.CosMantleMaxAlignmentAngle;
+
+	
+SLOG("Searching Mantle Surface")
+
+	// Check Front Face
+	// Probes are traced to the full reach so they can be shared between ticks, CheckDistance is applied to the hit.
+	FHitResult& FrontHit = OutFrontHit;
+	float ProbeDistance = FMath::Max(MantleMaxDistance, CapR() + 30);
+	FVector FrontStart = BaseLoc + FVector::UpVector * (MaxStepHeight - 1);
+	for (int i = 0; i < MantleFrontProbeCount; i++)
+	{
+		LINE(FrontStart, FrontStart + Fwd * CheckDistance, FColor::Red)
+		const FHitResult& ProbeHit = ResolveProbe(FMovementProbeBatch::Probe_MantleFront + i, FrontStart, FrontStart + Fwd * ProbeDistance);
+		if (ProbeHit.bBlockingHit && ProbeHit.Distance <= CheckDistance)
+		{
+			FrontHit = ProbeHit;
+			break;
+		}
+		FrontStart += FVector::UpVector * (2.f * CapHH() - (MaxStepHeight - 1)) / (MantleFrontProbeCount - 1);
+	}
+	if (!FrontHit.IsValidBlockingHit()) return false;
+	float CosWallSteepnessAngle = FrontHit.Normal | FVector::UpVector;
+	if (FMath::Abs(CosWallSteepnessAngle) > CosMMWSA || (Fwd | -FrontHit.Normal) < CosMMAA) return false;
+
+POINT(FrontHit.Location, FColor::Red);
+	
+	// Check Height
+	TArray<FHitResult>& HeightHits = HitScratch;
+	const int32 ScratchCapacity = HeightHits.Max();
+	HeightHits.Reset();
+	FHitResult& SurfaceHit = OutSurfaceHit;
+	FVector WallUp = FVector::VectorPlaneProject(FVector::UpVector, FrontHit.Normal).GetSafeNormal();
+	float WallCos = FVector::UpVector | FrontHit.Normal;
+	float WallSin = FMath::Sqrt(1 - WallCos * WallCos);
+	FVector TraceStart = FrontHit.Location + Fwd + WallUp * (MaxHeight - (MaxStepHeight - 1)) / WallSin;
+LINE(TraceStart, FrontHit.Location + Fwd, FColor::Orange)
+	COUNT_TRACES(1);
+	const bool bHeightHit = GetWorld()->LineTraceMultiByProfile(HeightHits, TraceStart, FrontHit.Location + Fwd, "BlockAll", Params);
+	SURVIVAL_COUNT_SCRATCH_QUERY(HeightHits.Max() == ScratchCapacity);
+	if (!bHeightHit) return false;
+	for (const FHitResult& Hit : HeightHits)
+	{
+		if (Hit.IsValidBlockingHit())
+		{
+			SurfaceHit = Hit;
+			break;
+		}
 	}
+	if (!SurfaceHit.IsValidBlockingHit() || (SurfaceHit.Normal | FVector::UpVector) < CosMMSA) return false;
+	OutHeight = (SurfaceHit.Location - BaseLoc) | FVector::UpVector;
+
+SLOG(FString::Printf(TEXT("Height: %f"), OutHeight))
+POINT(SurfaceHit.Location, FColor::Blue);
+	
+	if (OutHeight > MaxHeight) return false;
+	
 
+	// Check Clearance
+	float SurfaceCos = FVector::UpVector | SurfaceHit.Normal;
+	float SurfaceSin = FMath::Sqrt(1 - SurfaceCos * SurfaceCos);
+	FVector ClearCapLoc = SurfaceHit.Location + Fwd * CapR() + FVector::UpVector * (CapHH() + 1 + CapR() * 2 * SurfaceSin);
+	if (!IsCapsuleClearAt(ClearCapLoc))
+	{
+CAPSULE(ClearCapLoc, FColor::Red)
+		return false;
+	}
+	else
+	{
+CAPSULE(ClearCapLoc, FColor::Green)
+	}
 	return true;
 }
 
@@ -1219,30 +1911,30 @@ FVector USurvivalCharacterMovementComponent::GetMantleStartLocation(const FHitRe
 bool USurvivalCharacterMovementComponent::TryWallRun()
 {
 	if (!IsFalling()) return false;
-	if (Velocity.SizeSquared2D() < pow(MinWallRunSpeed, 2)) return false;
+	if (Velocity.SizeSquared2D() < Derived.MinWallRunSpeedSquared) return false;
 	if (Velocity.Z < -MaxVerticalWallRunSpeed) return false;
-	FVector Start = UpdatedComponent->GetComponentLocation();
-	FVector LeftEnd = Start - UpdatedComponent->GetRightVector() * CapR() * 2;
-	FVector RightEnd = Start + UpdatedComponent->GetRightVector() * CapR() * 2;
-	auto Params = ZippyCharacterOwner->GetIgnoreCharacterParams();
-	FHitResult FloorHit, WallHit;
+	FVector Start, FloorEnd, LeftEnd, RightEnd;
+	GetProbeSegment(FMovementProbeBatch::Probe_WallRunFloor, Start, FloorEnd);
+	GetProbeSegment(FMovementProbeBatch::Probe_WallRunLeft, Start, LeftEnd);
+	GetProbeSegment(FMovementProbeBatch::Probe_WallRunRight, Start, RightEnd);
 	// Check Player Height
-	if (GetWorld()->LineTraceSingleByProfile(FloorHit, Start, Start + FVector::DownVector * (CapHH() + MinWallRunHeight), "BlockAll", Params))
+	const FHitResult& FloorHit = ResolveProbe(FMovementProbeBatch::Probe_WallRunFloor, Start, FloorEnd);
+	if (FloorHit.bBlockingHit)
 	{
 		return false;
 	}
 	
 	// Left Cast
-	GetWorld()->LineTraceSingleByProfile(WallHit, Start, LeftEnd, "BlockAll", Params);
-	if (WallHit.IsValidBlockingHit() && (Velocity | WallHit.Normal) < 0)
+	const FHitResult* WallHit = &ResolveProbe(FMovementProbeBatch::Probe_WallRunLeft, Start, LeftEnd);
+	if (WallHit->IsValidBlockingHit() && (Velocity | WallHit->Normal) < 0)
 	{
 		Safe_bWallRunIsRight = false;
 	}
 	// Right Cast
 	else
 	{
-		GetWorld()->LineTraceSingleByProfile(WallHit, Start, RightEnd, "BlockAll", Params);
-		if (WallHit.IsValidBlockingHit() && (Velocity | WallHit.Normal) < 0)
+		WallHit = &ResolveProbe(FMovementProbeBatch::Probe_WallRunRight, Start, RightEnd);
+		if (WallHit->IsValidBlockingHit() && (Velocity | WallHit->Normal) < 0)
 		{
 			Safe_bWallRunIsRight = true;
 		}
@@ -1251,8 +1943,8 @@ bool USurvivalCharacterMovementComponent::TryWallRun()
 			return false;
 		}
 	}
-	FVector ProjectedVelocity = FVector::VectorPlaneProject(Velocity, WallHit.Normal);
-	if (ProjectedVelocity.SizeSquared2D() < pow(MinWallRunSpeed, 2)) return false;
+	FVector ProjectedVelocity = FVector::VectorPlaneProject(Velocity, WallHit->Normal);
+	if (ProjectedVelocity.SizeSquared2D() < Derived.MinWallRunSpeedSquared) return false;
 	
 	// Passed all conditions
 	Velocity = ProjectedVelocity;
@@ -1264,6 +1956,8 @@ SLOG("Starting WallRun")
 
 void USurvivalCharacterMovementComponent::PhysWallRun(float deltaTime, int32 Iterations)
 {
+	SURVIVAL_SCOPE_CYCLE_COUNTER(PhysWallRun);
+
 	if (deltaTime < MIN_TICK_TIME)
 	{
 		return;
@@ -1277,39 +1971,36 @@ void USurvivalCharacterMovementComponent::PhysWallRun(float deltaTime, int32 Ite
 	
 	bJustTeleported = false;
 	float remainingTime = deltaTime;
+	const float SinPullAwayAngle = Derived.SinWallRunPullAwayAngle;
 	// Perform the move
 	while ( (remainingTime >= MIN_TICK_TIME) && (Iterations < MaxSimulationIterations) && CharacterOwner && (CharacterOwner->Controller || bRunPhysicsWithNoController || (CharacterOwner->GetLocalRole() == ROLE_SimulatedProxy)) )
 	{
 		Iterations++;
 		bJustTeleported = false;
-		const float timeTick = GetSimulationTimeStep(remainingTime, Iterations);
+		const float timeTick = GetSurvivalSimulationTimeStep(remainingTime, Iterations);
 		remainingTime -= timeTick;
 		const FVector OldLocation = UpdatedComponent->GetComponentLocation();
 		
-		FVector Start = UpdatedComponent->GetComponentLocation();
-		FVector CastDelta = UpdatedComponent->GetRightVector() * CapR() * 2;
-		FVector End = Safe_bWallRunIsRight ? Start + CastDelta : Start - CastDelta;
-		auto Params = ZippyCharacterOwner->GetIgnoreCharacterParams();
-		float SinPullAwayAngle = FMath::Sin(FMath::DegreesToRadians(WallRunPullAwayAngle));
-		FHitResult WallHit;
-		GetWorld()->LineTraceSingleByProfile(WallHit, Start, End, "BlockAll", Params);
-		bool bWantsToPullAway = WallHit.IsValidBlockingHit() && !Acceleration.IsNearlyZero() && (Acceleration.GetSafeNormal() | WallHit.Normal) > SinPullAwayAngle;
-		if (!WallHit.IsValidBlockingHit() || bWantsToPullAway)
+		const FVector WallDirection = Safe_bWallRunIsRight ? UpdatedComponent->GetRightVector() : -UpdatedComponent->GetRightVector();
+		const FSurfaceContact& Wall = ResolveSurfaceContact(WallContact, WallDirection, CapR() * 2);
+		const FVector WallNormal = Wall.Normal;
+		bool bWantsToPullAway = Wall.bHit && !Acceleration.IsNearlyZero() && (Acceleration.GetSafeNormal() | WallNormal) > SinPullAwayAngle;
+		if (!Wall.bHit || bWantsToPullAway)
 		{
 			SetMovementMode(MOVE_Falling);
 			StartNewPhysics(remainingTime, Iterations);
 			return;
 		}
 		// Clamp Acceleration
-		Acceleration = FVector::VectorPlaneProject(Acceleration, WallHit.Normal);
+		Acceleration = FVector::VectorPlaneProject(Acceleration, WallNormal);
 		Acceleration.Z = 0.f;
 		// Apply acceleration
 		CalcVelocity(timeTick, 0.f, false, GetMaxBrakingDeceleration());
-		Velocity = FVector::VectorPlaneProject(Velocity, WallHit.Normal);
+		Velocity = FVector::VectorPlaneProject(Velocity, WallNormal);
 		float TangentAccel = Acceleration.GetSafeNormal() | Velocity.GetSafeNormal2D();
 		bool bVelUp = Velocity.Z > 0.f;
-		Velocity.Z += GetGravityZ() * WallRunGravityScaleCurve->GetFloatValue(bVelUp ? 0.f : TangentAccel) * timeTick;
-		if (Velocity.SizeSquared2D() < pow(MinWallRunSpeed, 2) || Velocity.Z < -MaxVerticalWallRunSpeed)
+		Velocity.Z += GetGravityZ() * WallRunGravityScale.Sample(bVelUp ? 0.f : TangentAccel) * timeTick;
+		if (Velocity.SizeSquared2D() < Derived.MinWallRunSpeedSquared || Velocity.Z < -MaxVerticalWallRunSpeed)
 		{
 			SetMovementMode(MOVE_Falling);
 			StartNewPhysics(remainingTime, Iterations);
@@ -1324,10 +2015,7 @@ void USurvivalCharacterMovementComponent::PhysWallRun(float deltaTime, int32 Ite
 		}
 		else
 		{
-			FHitResult Hit;
-			SafeMoveUpdatedComponent(Delta, UpdatedComponent->GetComponentQuat(), true, Hit);
-			FVector WallAttractionDelta = -WallHit.Normal * WallAttractionForce * timeTick;
-			SafeMoveUpdatedComponent(WallAttractionDelta, UpdatedComponent->GetComponentQuat(), true, Hit);
+			MoveAlongWall(Delta, Wall, timeTick);
 		}
 		if (UpdatedComponent->GetComponentLocation() == OldLocation)
 		{
@@ -1338,52 +2026,33 @@ void USurvivalCharacterMovementComponent::PhysWallRun(float deltaTime, int32 Ite
 	}
 
 	
-	FVector Start = UpdatedComponent->GetComponentLocation();
-	FVector CastDelta = UpdatedComponent->GetRightVector() * CapR() * 2;
-	FVector End = Safe_bWallRunIsRight ? Start + CastDelta : Start - CastDelta;
-	auto Params = ZippyCharacterOwner->GetIgnoreCharacterParams();
-	FHitResult FloorHit, WallHit;
-	GetWorld()->LineTraceSingleByProfile(WallHit, Start, End, "BlockAll", Params);
-	GetWorld()->LineTraceSingleByProfile(FloorHit, Start, Start + FVector::DownVector * (CapHH() + MinWallRunHeight * .5f), "BlockAll", Params);
-	if (FloorHit.IsValidBlockingHit() || !WallHit.IsValidBlockingHit() || Velocity.SizeSquared2D() < pow(MinWallRunSpeed, 2))
+	const FVector WallDirection = Safe_bWallRunIsRight ? UpdatedComponent->GetRightVector() : -UpdatedComponent->GetRightVector();
+	const bool bWallHit = ResolveSurfaceContact(WallContact, WallDirection, CapR() * 2).bHit;
+	const bool bFloorHit = ResolveSurfaceContact(FloorContact, FVector::DownVector, CapHH() + MinWallRunHeight * .5f).bHit;
+	if (bFloorHit || !bWallHit || Velocity.SizeSquared2D() < Derived.MinWallRunSpeedSquared)
 	{
 		SetMovementMode(MOVE_Falling);
 	}
 }
 
-bool USurvivalCharacterMovementComponent::TryHang()
+bool USurvivalCharacterMovementComponent::TryHang(bool bChained)
 {
-	if (!IsMovementMode(MOVE_Falling)) return false;
+	SURVIVAL_SCOPE_CYCLE_COUNTER(TryHang);
 
+	if (!IsMovementMode(MOVE_Falling) && !bChained) return false;
 
-	FHitResult WallHit;
-	if (!GetWorld()->LineTraceSingleByProfile(WallHit, UpdatedComponent->GetComponentLocation(), UpdatedComponent->GetComponentLocation() + UpdatedComponent->GetForwardVector() * 300, "BlockAll", ZippyCharacterOwner->GetIgnoreCharacterParams()))
-		return false;
+	const UClimbPointSubsystem* ClimbPoints = GetWorld()->GetSubsystem<UClimbPointSubsystem>();
+	if (!ClimbPoints) return false;
 
-	TArray<FOverlapResult> OverlapResults;
+	const FHitResult& WallHit = ResolveForwardProbe();
+	if (!WallHit.bBlockingHit || WallHit.Distance > HangReachDistance)
+		return false;
 
 	FVector ColLoc = UpdatedComponent->GetComponentLocation() + FVector::UpVector * CapHH() + UpdatedComponent->GetForwardVector() * CapR() * 3;
-	auto ColBox = FCollisionShape::MakeBox(FVector(100, 100, 50));
+	FVector ColExtent = FVector(100, 100, 50);
 	FQuat ColRot = FRotationMatrix::MakeFromXZ(WallHit.Normal, FVector::UpVector).ToQuat();
 
-	if (!GetWorld()->OverlapMultiByChannel(OverlapResults, ColLoc, ColRot, ECC_WorldStatic, ColBox, ZippyCharacterOwner->GetIgnoreCharacterParams()))
-		return false;
-
-	AActor* ClimbPoint = nullptr;
-	
-	float MaxHeight = -1e20;
-	for (FOverlapResult Result : OverlapResults)
-	{
-		if (Result.GetActor()->ActorHasTag("Climb Point"))
-		{
-			float Height = Result.GetActor()->GetActorLocation().Z;
-			if (Height > MaxHeight)
-			{
-				MaxHeight = Height;
-				ClimbPoint = Result.GetActor();
-			}
-		}
-	}
+	AActor* ClimbPoint = ClimbPoints->FindHighestClimbPoint(ColLoc, ColRot, ColExtent);
 	if (!IsValid(ClimbPoint)) return false;
 
 	FVector TargetLocation = ClimbPoint->GetActorLocation() + WallHit.Normal * CapR() * 1.01f + FVector::DownVector * CapHH();
@@ -1391,15 +2060,13 @@ bool USurvivalCharacterMovementComponent::TryHang()
 
 	
 	// Test if character can reach goal
-	FTransform CurrentTransform = UpdatedComponent->GetComponentTransform();
-	FHitResult Hit, ReturnHit;
-	SafeMoveUpdatedComponent(TargetLocation - UpdatedComponent->GetComponentLocation(), UpdatedComponent->GetComponentQuat(), true, Hit);
-	FVector ResultLocation = UpdatedComponent->GetComponentLocation();
-	SafeMoveUpdatedComponent(CurrentTransform.GetLocation() - ResultLocation, TargetRotation, false, ReturnHit);
-	if (!ResultLocation.Equals(TargetLocation)) return false;
+	if (!IsCapsulePathClear(UpdatedComponent->GetComponentLocation(), TargetLocation)) return false;
 
 	// Passed all conditions
 
+	FHitResult Hit;
+	SafeMoveUpdatedComponent(FVector::ZeroVector, TargetRotation, false, Hit);
+
 	bOrientRotationToMovement = false;
 	
 	// Perform Transition to Climb Point
@@ -1407,8 +2074,8 @@ bool USurvivalCharacterMovementComponent::TryHang()
 	float TransDistance = FVector::Dist(TargetLocation, UpdatedComponent->GetComponentLocation());
 
 	TransitionQueuedMontageSpeed = FMath::GetMappedRangeValueClamped(FVector2D(-500, 750), FVector2D(.9f, 1.2f), UpSpeed);
-	TransitionRMS.Reset();
-	TransitionRMS = MakeShared<FRootMotionSource_MoveToForce>();
+	const TSharedPtr<FRootMotionSource_MoveToForce> Source = AcquireTransitionRMS();
+	TransitionRMS = Source.Get();
 	TransitionRMS->AccumulateMode = ERootMotionAccumulateMode::Override;
 	
 	TransitionRMS->Duration = FMath::Clamp(TransDistance / 500.f, .1f, .25f);
@@ -1418,28 +2085,27 @@ bool USurvivalCharacterMovementComponent::TryHang()
 	// Apply Transition Root Motion Source
 	Velocity = FVector::ZeroVector;
 	SetMovementMode(MOVE_Flying);
-	TransitionRMS_ID = ApplyRootMotionSource(TransitionRMS);
+	TransitionRMS_ID = ApplyRootMotionSource(Source);
+
+	Safe_Transition = ESurvivalTransition::Hang;
 
 	// Animations
-	TransitionQueuedMontage = nullptr;
-	TransitionName = "Hang";
 	CharacterOwner->PlayAnimMontage(TransitionHangMontage, 1 / TransitionRMS->Duration);
 
 	return true;
 }
 
-bool USurvivalCharacterMovementComponent::TryClimb()
+bool USurvivalCharacterMovementComponent::TryClimb(bool bChained)
 {
-	if (!IsFalling()) return false;
+	if (!IsFalling() && !bChained) return false;
 
-	FHitResult SurfHit;
-	FVector CapLoc = UpdatedComponent->GetComponentLocation();
-	GetWorld()->LineTraceSingleByProfile(SurfHit, CapLoc, CapLoc + UpdatedComponent->GetForwardVector() * ClimbReachDistance, "BlockAll", ZippyCharacterOwner->GetIgnoreCharacterParams());
+	const FHitResult& SurfHit = ResolveForwardProbe();
 
-	if (!SurfHit.IsValidBlockingHit()) return false;
+	if (!SurfHit.IsValidBlockingHit() || SurfHit.Distance > ClimbReachDistance) return false;
 
 	FQuat NewRotation = FRotationMatrix::MakeFromXZ(-SurfHit.Normal, FVector::UpVector).ToQuat();
-	SafeMoveUpdatedComponent(FVector::ZeroVector, NewRotation, false, SurfHit);
+	FHitResult Hit;
+	SafeMoveUpdatedComponent(FVector::ZeroVector, NewRotation, false, Hit);
 
 	SetMovementMode(MOVE_Custom, CMOVE_Climb);
 
@@ -1450,6 +2116,8 @@ bool USurvivalCharacterMovementComponent::TryClimb()
 
 void USurvivalCharacterMovementComponent::PhysClimb(float deltaTime, int32 Iterations)
 {
+	SURVIVAL_SCOPE_CYCLE_COUNTER(PhysClimb);
+
 	if (deltaTime < MIN_TICK_TIME)
 	{
 		return;
@@ -1465,10 +2133,11 @@ void USurvivalCharacterMovementComponent::PhysClimb(float deltaTime, int32 Itera
 	bJustTeleported = false;
 	Iterations++;
 	const FVector OldLocation = UpdatedComponent->GetComponentLocation();
-	FHitResult SurfHit, FloorHit;
-	GetWorld()->LineTraceSingleByProfile(SurfHit, OldLocation, OldLocation + UpdatedComponent->GetForwardVector() * ClimbReachDistance, "BlockAll", ZippyCharacterOwner->GetIgnoreCharacterParams());
-	GetWorld()->LineTraceSingleByProfile(FloorHit, OldLocation, OldLocation + FVector::DownVector * CapHH() * 1.2f, "BlockAll", ZippyCharacterOwner->GetIgnoreCharacterParams());
-	if (!SurfHit.IsValidBlockingHit() || FloorHit.IsValidBlockingHit())
+	const FSurfaceContact& Surf = ResolveSurfaceContact(WallContact, UpdatedComponent->GetForwardVector(), ClimbReachDistance);
+	const FVector SurfNormal = Surf.Normal;
+	const bool bSurfHit = Surf.bHit;
+	const bool bFloorHit = ResolveSurfaceContact(FloorContact, FVector::DownVector, CapHH() * 1.2f).bHit;
+	if (!bSurfHit || bFloorHit)
 	{
 		SetMovementMode(MOVE_Falling);
 		StartNewPhysics(deltaTime, Iterations);
@@ -1481,16 +2150,13 @@ void USurvivalCharacterMovementComponent::PhysClimb(float deltaTime, int32 Itera
 
 	// Apply acceleration
 	CalcVelocity(deltaTime, 0.f, false, GetMaxBrakingDeceleration());
-	Velocity = FVector::VectorPlaneProject(Velocity, SurfHit.Normal);
+	Velocity = FVector::VectorPlaneProject(Velocity, SurfNormal);
 
 	// Compute move parameters
 	const FVector Delta = deltaTime * Velocity; // dx = v * dt
 	if (!Delta.IsNearlyZero())
 	{
-		FHitResult Hit;
-		SafeMoveUpdatedComponent(Delta, UpdatedComponent->GetComponentQuat(), true, Hit);
-		FVector WallAttractionDelta = -SurfHit.Normal * WallAttractionForce * deltaTime;
-		SafeMoveUpdatedComponent(WallAttractionDelta, UpdatedComponent->GetComponentQuat(), true, Hit);
+		MoveAlongWall(Delta, Surf, deltaTime);
 	}
 
 	Velocity = (UpdatedComponent->GetComponentLocation() - OldLocation) / deltaTime; // v = dx / dt
@@ -1498,6 +2164,443 @@ void USurvivalCharacterMovementComponent::PhysClimb(float deltaTime, int32 Itera
 
 #pragma endregion
 
+#pragma region Transitions
+
+void USurvivalCharacterMovementComponent::QueueTransition(ESurvivalTransition Transition)
+{
+	Safe_QueuedTransition = Transition;
+}
+
+TSharedPtr<FRootMotionSource_MoveToForce> USurvivalCharacterMovementComponent::AcquireTransitionRMS()
+{
+	for (const TSharedPtr<FRootMotionSource_MoveToForce>& Source : TransitionRMSPool)
+	{
+		if (Source.IsUnique())
+		{
+			*Source = FRootMotionSource_MoveToForce();
+			return Source;
+		}
+	}
+
+	return TransitionRMSPool.Add_GetRef(MakeShared<FRootMotionSource_MoveToForce>());
+}
+
+bool USurvivalCharacterMovementComponent::TryProbe(EProbeDecision Probe)
+{
+	if (bClientUpdating && bReplayProbeDecisions && (ReplayProbeFailures & Probe))
+	{
+		ProbeFailures |= Probe;
+		return false;
+	}
+
+	bool bSucceeded = false;
+	switch (Probe)
+	{
+	case PROBE_Mantle:
+		bSucceeded = TryMantle();
+		break;
+	case PROBE_Hang:
+		bSucceeded = TryHang();
+		break;
+	case PROBE_Climb:
+		bSucceeded = TryClimb();
+		break;
+	case PROBE_WallRun:
+		bSucceeded = TryWallRun();
+		break;
+	}
+
+	if (!bSucceeded) ProbeFailures |= Probe;
+	return bSucceeded;
+}
+
+void USurvivalCharacterMovementComponent::FinishTransition()
+{
+	const ESurvivalTransition Finished = Safe_Transition;
+	const ESurvivalTransition Next = Safe_QueuedTransition;
+
+	Safe_Transition = ESurvivalTransition::None;
+	Safe_QueuedTransition = ESurvivalTransition::None;
+	Safe_bTransitionFinished = false;
+
+	switch (Finished)
+	{
+	case ESurvivalTransition::ShortMantle:
+	case ESurvivalTransition::TallMantle:
+		{
+			// A chained transition takes over from here, so skip the mantle follow-up montage
+			UAnimMontage* FollowUpMontage = Finished == ESurvivalTransition::TallMantle ? TallMantleMontage : ShortMantleMontage;
+			if (Next == ESurvivalTransition::None && IsValid(FollowUpMontage))
+			{
+				SetMovementMode(MOVE_Flying);
+				CharacterOwner->PlayAnimMontage(FollowUpMontage, TransitionQueuedMontageSpeed);
+			}
+			else
+			{
+				SetMovementMode(MOVE_Walking);
+			}
+		}
+		break;
+	case ESurvivalTransition::Hang:
+		SetMovementMode(MOVE_Custom, CMOVE_Hang);
+		Velocity = FVector::ZeroVector;
+		break;
+	default:
+		break;
+	}
+	TransitionQueuedMontageSpeed = 0.f;
+
+	switch (Next)
+	{
+	case ESurvivalTransition::Hang:
+		TryHang(true);
+		break;
+	case ESurvivalTransition::Climb:
+		TryClimb(true);
+		break;
+	default:
+		break;
+	}
+}
+
+#pragma endregion
+
+#pragma region Probes
+
+const FHitResult& USurvivalCharacterMovementComponent::ResolveProbe(int32 Probe, const FVector& Start, const FVector& End)
+{
+	check(Probe >= 0 && Probe < FMovementProbeBatch::Probe_Num);
+
+	// Start a new batch once the capsule the probes were traced from no longer matches our own.
+	const FVector Location = UpdatedComponent->GetComponentLocation();
+	const FQuat Rotation = UpdatedComponent->GetComponentQuat();
+	if (ProbeBatch.Frame + 1 < GFrameCounter
+		|| !FVector::PointsAreNear(ProbeBatch.Origin, Location, ProbeReuseTolerance)
+		|| !ProbeBatch.Rotation.Equals(Rotation, UE_KINDA_SMALL_NUMBER)
+		|| ProbeBatch.CapsuleHalfHeight != CapHH())
+	{
+		ProbeBatch.Origin = Location;
+		ProbeBatch.Rotation = Rotation;
+		ProbeBatch.CapsuleHalfHeight = CapHH();
+		ProbeBatch.Frame = GFrameCounter;
+		ProbeBatch.ResolvedMask = 0;
+	}
+
+	FHitResult& Hit = ProbeBatch.Hits[Probe];
+	const uint32 ProbeBit = 1u << Probe;
+	if (!(ProbeBatch.ResolvedMask & ProbeBit))
+	{
+		Hit.Reset(1.f, false);
+		COUNT_TRACES(1);
+		GetWorld()->LineTraceSingleByProfile(Hit, Start, End, "BlockAll", ZippyCharacterOwner->GetIgnoreCharacterParams());
+		if (IsProbeHitReusable(Hit)) ProbeBatch.ResolvedMask |= ProbeBit;
+	}
+	return Hit;
+}
+
+bool USurvivalCharacterMovementComponent::IsProbeHitReusable(const FHitResult& Hit)
+{
+	const UPrimitiveComponent* HitComponent = Hit.GetComponent();
+	return !HitComponent || HitComponent->Mobility == EComponentMobility::Static;
+}
+
+void USurvivalCharacterMovementComponent::InvalidateProbeBatch()
+{
+	ProbeBatch.Frame = 0;
+	ProbeBatch.ResolvedMask = 0;
+}
+
+const FHitResult& USurvivalCharacterMovementComponent::ResolveForwardProbe()
+{
+	FVector Start, End;
+	GetProbeSegment(FMovementProbeBatch::Probe_Forward, Start, End);
+	return ResolveProbe(FMovementProbeBatch::Probe_Forward, Start, End);
+}
+
+void USurvivalCharacterMovementComponent::GetProbeSegment(int32 Probe, FVector& OutStart, FVector& OutEnd) const
+{
+	OutStart = UpdatedComponent->GetComponentLocation();
+	switch (Probe)
+	{
+	case FMovementProbeBatch::Probe_WallRunFloor:
+		OutEnd = OutStart + FVector::DownVector * (CapHH() + MinWallRunHeight);
+		break;
+	case FMovementProbeBatch::Probe_WallRunLeft:
+		OutEnd = OutStart - UpdatedComponent->GetRightVector() * CapR() * 2;
+		break;
+	case FMovementProbeBatch::Probe_WallRunRight:
+		OutEnd = OutStart + UpdatedComponent->GetRightVector() * CapR() * 2;
+		break;
+	case FMovementProbeBatch::Probe_Forward:
+		OutEnd = OutStart + UpdatedComponent->GetForwardVector() * FMath::Max(HangReachDistance, ClimbReachDistance);
+		break;
+	default:
+		checkNoEntry();
+		OutEnd = OutStart;
+		break;
+	}
+}
+
+void USurvivalCharacterMovementComponent::SetForceFullSignificance(bool bForce)
+{
+	bForceFullSignificance = bForce;
+	if (bForce) ApplySignificance(Significance_Full);
+}
+
+float USurvivalCharacterMovementComponent::CalculateSignificance(const FTransform& Viewpoint) const
+{
+	if (bForceFullSignificance || !UpdatedComponent) return Significance_Full;
+
+	const float DistSquared = FVector::DistSquared(Viewpoint.GetLocation(), UpdatedComponent->GetComponentLocation());
+	if (DistSquared <= FMath::Square(SignificanceFullDistance)) return Significance_Full;
+	if (DistSquared <= FMath::Square(SignificanceReducedDistance)) return Significance_Reduced;
+	return Significance_Minimal;
+}
+
+void USurvivalCharacterMovementComponent::ApplySignificance(float Significance)
+{
+	const ESignificanceLevel Level = static_cast<ESignificanceLevel>(FMath::Clamp(FMath::RoundToInt(Significance), 0, (int32)Significance_Full));
+	if (Level == SignificanceLevel) return;
+
+	SignificanceLevel = Level;
+	bCoarseSimulation = Level != Significance_Full;
+	switch (Level)
+	{
+	case Significance_Full:
+		SetComponentTickInterval(0.f);
+		break;
+	case Significance_Reduced:
+		SetComponentTickInterval(ReducedTickInterval);
+		break;
+	case Significance_Minimal:
+		SetComponentTickInterval(MinimalTickInterval);
+		break;
+	}
+}
+
+float USurvivalCharacterMovementComponent::GetSurvivalSimulationTimeStep(float RemainingTime, int32 Iterations) const
+{
+	if (!bCoarseSimulation) return GetSimulationTimeStep(RemainingTime, Iterations);
+
+	// One step covers a normal coarse tick, longer frames are still split so a hitch cannot become a single unbounded step
+	if (Iterations >= MaxSimulationIterations) return RemainingTime;
+	return FMath::Min(RemainingTime, FMath::Max(MinimalTickInterval, MaxSimulationTimeStep));
+}
+
+void USurvivalCharacterMovementComponent::ReplayCapturedMove(const FSurvivalMoveCaptureRecord& Record)
+{
+	ApplySurvivalInputFlags(Record.SurvivalFlags);
+	Safe_CrouchHoldTime = Record.CrouchHoldTime;
+	Safe_DashCooldownLeft = Record.DashCooldownLeft;
+
+	// As the server does with the control rotation a client move arrives with
+	if (AController* Controller = CharacterOwner->GetController())
+	{
+		Controller->SetControlRotation(FRotator(Record.ControlRotation));
+		CharacterOwner->FaceRotation(FRotator(Record.ControlRotation), Record.DeltaTime);
+	}
+
+	MoveAutonomous(Record.TimeStamp, Record.DeltaTime, Record.CompressedFlags, FVector(Record.Acceleration));
+}
+
+void USurvivalCharacterMovementComponent::CaptureMove(const FSavedMove_SurvivalCharacter& Move)
+{
+	FSurvivalMoveCaptureRecord Record;
+	Record.Type = FSurvivalMoveCaptureRecord::Type_Move;
+	Record.CompressedFlags = Move.GetCompressedFlags();
+	Record.SurvivalFlags = Move.GetSurvivalFlags();
+	Record.StartPackedMode = Move.StartPackedMovementMode;
+	Record.EndPackedMode = Move.EndPackedMovementMode;
+	Record.Transition = Move.Saved_Transition;
+	Record.TimeStamp = Move.TimeStamp;
+	Record.DeltaTime = Move.DeltaTime;
+	Record.Acceleration = FVector3f(Move.Acceleration);
+	Record.Location = FVector3f(Move.StartLocation);
+	Record.Velocity = FVector3f(Move.StartVelocity);
+	Record.Rotation = FRotator3f(Move.StartRotation);
+	Record.ControlRotation = FRotator3f(Move.SavedControlRotation);
+	Record.EndLocation = FVector3f(Move.SavedLocation);
+	Record.CrouchHoldTime = Move.Saved_CrouchHoldTime;
+	Record.DashCooldownLeft = Move.Saved_DashCooldownLeft;
+	CaptureWriter->Push(Record, bCaptureCombinedMove);
+	bCaptureCombinedMove = false;
+}
+
+void USurvivalCharacterMovementComponent::PrefetchProbes()
+{
+	if (!UpdatedComponent || !CharacterOwner || CharacterOwner->IsPlayerControlled()) return;
+
+	const FCollisionQueryParams& Params = ZippyCharacterOwner->GetIgnoreCharacterParams();
+	auto QueueTrace = [this, &Params](const FVector& Start, const FVector& End, uint32 UserData)
+	{
+		COUNT_TRACES(1);
+		GetWorld()->AsyncLineTraceByProfile(EAsyncTraceType::Single, Start, End, "BlockAll", Params, &PrefetchTraceDelegate, UserData);
+	};
+	// Record the query on the contact now so the result matches what ResolveSurfaceContact asks for exactly
+	auto QueueContact = [this, &QueueTrace](FSurfaceContact& Contact, const FVector& Direction, float TraceLength, uint32 UserData)
+	{
+		Contact.bValid = false;
+		Contact.Origin = UpdatedComponent->GetComponentLocation();
+		Contact.Direction = Direction;
+		Contact.TraceLength = TraceLength;
+		QueueTrace(Contact.Origin, Contact.Origin + Direction * TraceLength, UserData);
+	};
+
+	if (IsFalling())
+	{
+		// Start the batch now so the results are kept when the next tick begins from the same capsule
+		ProbeBatch.Origin = UpdatedComponent->GetComponentLocation();
+		ProbeBatch.Rotation = UpdatedComponent->GetComponentQuat();
+		ProbeBatch.CapsuleHalfHeight = CapHH();
+		ProbeBatch.Frame = GFrameCounter;
+		ProbeBatch.ResolvedMask = 0;
+
+		static constexpr FMovementProbeBatch::EProbe FallingProbes[] = {
+			FMovementProbeBatch::Probe_WallRunFloor, FMovementProbeBatch::Probe_WallRunLeft, FMovementProbeBatch::Probe_WallRunRight, FMovementProbeBatch::Probe_Forward
+		};
+		for (const FMovementProbeBatch::EProbe Probe : FallingProbes)
+		{
+			FVector Start, End;
+			GetProbeSegment(Probe, Start, End);
+			QueueTrace(Start, End, Probe);
+		}
+	}
+	else if (IsWallRunning() || IsClimbing())
+	{
+		if (IsWallRunning())
+		{
+			const FVector WallDirection = Safe_bWallRunIsRight ? UpdatedComponent->GetRightVector() : -UpdatedComponent->GetRightVector();
+			QueueContact(WallContact, WallDirection, CapR() * 2, PrefetchWallContact);
+			QueueContact(FloorContact, FVector::DownVector, CapHH() + MinWallRunHeight * .5f, PrefetchFloorContact);
+		}
+		else
+		{
+			QueueContact(WallContact, UpdatedComponent->GetForwardVector(), ClimbReachDistance, PrefetchWallContact);
+			QueueContact(FloorContact, FVector::DownVector, CapHH() * 1.2f, PrefetchFloorContact);
+		}
+	}
+}
+
+void USurvivalCharacterMovementComponent::OnPrefetchTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	FHitResult Hit;
+	if (TraceDatum.OutHits.Num() > 0) Hit = TraceDatum.OutHits[0];
+
+	if (TraceDatum.UserData < FMovementProbeBatch::Probe_Num)
+	{
+		// Drop results for a batch that has been restarted since the trace was queued
+		if (!ProbeBatch.Origin.Equals(TraceDatum.Start)) return;
+
+		if (!IsProbeHitReusable(Hit)) return;
+
+		ProbeBatch.Hits[TraceDatum.UserData] = Hit;
+		ProbeBatch.ResolvedMask |= 1u << TraceDatum.UserData;
+		return;
+	}
+
+	// The query was recorded on the contact when queued, drop the result if it has been traced or invalidated since
+	FSurfaceContact& Contact = TraceDatum.UserData == PrefetchWallContact ? WallContact : FloorContact;
+	if (Contact.bValid || !Contact.Origin.Equals(TraceDatum.Start)) return;
+
+	Contact.bValid = true;
+	Contact.bHit = Hit.IsValidBlockingHit();
+	Contact.Normal = Hit.Normal;
+	Contact.Distance = Hit.Distance;
+	Contact.Component = Hit.GetComponent();
+}
+
+bool USurvivalCharacterMovementComponent::IsCapsulePathClear(const FVector& Start, const FVector& End)
+{
+	// Sweep with our own collision so only what would stop the capsule moving there blocks it
+	FCollisionQueryParams QueryParams = ZippyCharacterOwner->GetIgnoreCharacterParams();
+	FCollisionResponseParams ResponseParams;
+	InitCollisionParams(QueryParams, ResponseParams);
+
+	FHitResult Hit;
+	COUNT_TRACES(1);
+	return !GetWorld()->SweepSingleByChannel(Hit, Start, End, UpdatedComponent->GetComponentQuat(), UpdatedComponent->GetCollisionObjectType(),
+		FCollisionShape::MakeCapsule(CapR(), CapHH()), QueryParams, ResponseParams);
+}
+
+bool USurvivalCharacterMovementComponent::IsCapsuleClearAt(const FVector& Location)
+{
+	COUNT_TRACES(1);
+	return !GetWorld()->OverlapAnyTestByProfile(Location, FQuat::Identity, "BlockAll", FCollisionShape::MakeCapsule(CapR(), CapHH()), ZippyCharacterOwner->GetIgnoreCharacterParams());
+}
+
+const USurvivalCharacterMovementComponent::FSurfaceContact& USurvivalCharacterMovementComponent::ResolveSurfaceContact(FSurfaceContact& Contact, const FVector& Direction, float TraceLength)
+{
+	const FVector Location = UpdatedComponent->GetComponentLocation();
+	const bool bSameQuery = Contact.bValid
+		&& FVector::Coincident(Contact.Direction, Direction)
+		&& FMath::IsNearlyEqual(Contact.TraceLength, TraceLength);
+
+	// Only a result traced from right here, such as a prefetch, still holds, anywhere else a floor may have come into reach
+	if (bSameQuery && Location.Equals(Contact.Origin))
+	{
+		return Contact;
+	}
+
+	const FCollisionQueryParams& Params = ZippyCharacterOwner->GetIgnoreCharacterParams();
+	FHitResult Hit;
+
+	// The wall was there last time, check just past where it should be now before paying for the full trace
+	bool bHit = false;
+	if (bSameQuery && Contact.bHit)
+	{
+		const float PredictedDistance = Contact.Distance - ((Location - Contact.Origin) | Direction);
+		const float ShortLength = FMath::Clamp(PredictedDistance + CapR(), 0.f, TraceLength);
+		if (ShortLength < TraceLength)
+		{
+			COUNT_TRACES(1);
+			bHit = GetWorld()->LineTraceSingleByProfile(Hit, Location, Location + Direction * ShortLength, "BlockAll", Params);
+		}
+	}
+	if (!bHit)
+	{
+		COUNT_TRACES(1);
+		bHit = GetWorld()->LineTraceSingleByProfile(Hit, Location, Location + Direction * TraceLength, "BlockAll", Params);
+	}
+
+	Contact.bValid = true;
+	Contact.bHit = Hit.IsValidBlockingHit();
+	Contact.Origin = Location;
+	Contact.Direction = Direction;
+	Contact.TraceLength = TraceLength;
+	Contact.Normal = Hit.Normal;
+	Contact.Distance = Hit.Distance;
+	Contact.Component = Hit.GetComponent();
+	return Contact;
+}
+
+void USurvivalCharacterMovementComponent::InvalidateSurfaceContacts()
+{
+	WallContact.bValid = false;
+	FloorContact.bValid = false;
+}
+
+void USurvivalCharacterMovementComponent::MoveAlongWall(const FVector& Delta, const FSurfaceContact& Wall, float DeltaTime)
+{
+	// Pull in no further than the wall, so the sweep stops short of it and needs no slide afterwards
+	const FVector Location = UpdatedComponent->GetComponentLocation();
+	const float WallDistance = (Wall.Distance - ((Location - Wall.Origin) | Wall.Direction)) * (Wall.Direction | -Wall.Normal);
+	const float Attraction = FMath::Min(WallAttractionForce * DeltaTime, FMath::Max(WallDistance - CapR() - WALL_CONTACT_SKIN, 0.f));
+	const FVector AttractedDelta = Delta - Wall.Normal * Attraction;
+
+	FHitResult Hit;
+	SafeMoveUpdatedComponent(AttractedDelta, UpdatedComponent->GetComponentQuat(), true, Hit);
+	if (Hit.IsValidBlockingHit())
+	{
+		if (Hit.GetComponent() != WallContact.Component.Get())
+		{
+			InvalidateSurfaceContacts();
+		}
+		SlideAlongSurface(AttractedDelta, 1.f - Hit.Time, Hit.Normal, Hit, true);
+	}
+}
+
+#pragma endregion
+
 #pragma region Helpers
 
 bool USurvivalCharacterMovementComponent::IsServer() const
@@ -1505,6 +2608,50 @@ bool USurvivalCharacterMovementComponent::IsServer() const
 	return CharacterOwner->HasAuthority();
 }
 
+bool USurvivalCharacterMovementComponent::IsNetworkPredicted() const
+{
+	return CharacterOwner->GetLocalRole() == ROLE_AutonomousProxy
+		|| (CharacterOwner->GetLocalRole() == ROLE_Authority && CharacterOwner->GetRemoteRole() == ROLE_AutonomousProxy);
+}
+
+FVector USurvivalCharacterMovementComponent::RoundAcceleration(FVector InAccel) const
+{
+	// Custom modes steer with whole units, everything else keeps the stock single decimal
+	if (MovementMode == MOVE_Custom) return FVector(FMath::RoundToFloat(InAccel.X), FMath::RoundToFloat(InAccel.Y), FMath::RoundToFloat(InAccel.Z));
+
+	return FVector(
+		FMath::RoundToFloat(InAccel.X * 10.f) / 10.f,
+		FMath::RoundToFloat(InAccel.Y * 10.f) / 10.f,
+		FMath::RoundToFloat(InAccel.Z * 10.f) / 10.f);
+}
+
+bool USurvivalCharacterMovementComponent::ComputeProxyLowDetail() const
+{
+	if (ProxyLowDetailDistance <= 0.f || !UpdatedComponent) return false;
+
+	const APlayerController* PC = GetWorld()->GetFirstPlayerController();
+	if (!PC || !PC->PlayerCameraManager) return false;
+
+	return FVector::DistSquared(PC->PlayerCameraManager->GetCameraLocation(), UpdatedComponent->GetComponentLocation()) > FMath::Square(ProxyLowDetailDistance);
+}
+
+bool USurvivalCharacterMovementComponent::IsInSteadyCombineMode() const
+{
+	if (!bCombineSteadyCustomMoves || MovementMode != MOVE_Custom || Safe_bWantsToDash) return false;
+
+	switch (CustomMovementMode)
+	{
+	case CMOVE_Slide:
+	case CMOVE_Prone:
+	case CMOVE_WallRun:
+	case CMOVE_Hang:
+	case CMOVE_Climb:
+		return true;
+	default:
+		return false;
+	}
+}
+
 float USurvivalCharacterMovementComponent::CapR() const
 {
 	return CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleRadius();
@@ -1540,29 +2687,64 @@ void USurvivalCharacterMovementComponent::StopSlide()
 void USurvivalCharacterMovementComponent::StartCrouch()
 {
 	bWantsToCrouch = !bWantsToCrouch;
-	GetWorld()->GetTimerManager().SetTimer(TimerHandle_EnterProne, this, &USurvivalCharacterMovementComponent::OnTryEnterProne, ProneEnterHoldDuration);
+	Safe_bCrouchHeld = true;
 }
 void USurvivalCharacterMovementComponent::StopCrouch()
 {
-	GetWorld()->GetTimerManager().ClearTimer(TimerHandle_EnterProne);
+	Safe_bCrouchHeld = false;
 }
 
 void USurvivalCharacterMovementComponent::StartDash()
 {
-	float CurrentTime = GetWorld()->GetTimeSeconds();
-	if (CurrentTime - DashStartTime >= DashCooldownDuration)
+	Safe_bWantsToDash = true;
+}
+void USurvivalCharacterMovementComponent::StopDash()
+{
+	Safe_bWantsToDash = false;
+}
+
+void USurvivalCharacterMovementComponent::BufferPress(EBufferedInput Input)
+{
+	FBufferedPress& Press = BufferedPresses[Input];
+	Press.PressTime = GetWorld()->GetTimeSeconds();
+	Press.bPending = true;
+	Press.bHeld = true;
+}
+void USurvivalCharacterMovementComponent::BufferRelease(EBufferedInput Input)
+{
+	BufferedPresses[Input].bHeld = false;
+}
+
+void USurvivalCharacterMovementComponent::ApplyBufferedInputs()
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+	for (FBufferedPress& Press : BufferedPresses)
 	{
-		Safe_bWantsToDash = true;
+		if (Press.bPending && Now - Press.PressTime > InputBufferDuration) Press.bPending = false;
 	}
-	else
+
+	// A jump is one attempt per press, kept pending so a press just before landing still jumps
+	if (BufferedPresses[INPUT_Jump].bPending) ZippyCharacterOwner->bPressedZippyJump = true;
+
+	// The others last while held, so a dash or prone held through its cooldown or in the air goes once it can.
+	// Flags are only written once the action has been pressed through the buffer, leaving StartSlide/StartDash usable on their own.
+	auto ApplyHeld = [](const FBufferedPress& Press, bool& bFlag)
 	{
-		GetWorld()->GetTimerManager().SetTimer(TimerHandle_DashCooldown, this, &USurvivalCharacterMovementComponent::OnDashCooldownFinished, DashCooldownDuration - (CurrentTime - DashStartTime));
-	}
+		if (Press.PressTime > 0.) bFlag = Press.bPending || Press.bHeld;
+	};
+	ApplyHeld(BufferedPresses[INPUT_Slide], Safe_bWantsToSlide);
+	ApplyHeld(BufferedPresses[INPUT_Dash], Safe_bWantsToDash);
+	ApplyHeld(BufferedPresses[INPUT_Prone], Safe_bWantsToProne);
 }
-void USurvivalCharacterMovementComponent::StopDash()
+
+void USurvivalCharacterMovementComponent::ConsumeBufferedPress(EBufferedInput Input)
 {
-	GetWorld()->GetTimerManager().ClearTimer(TimerHandle_DashCooldown);
-	Safe_bWantsToDash = false;
+	if (bClientUpdating) return;
+
+	FBufferedPress& Press = BufferedPresses[Input];
+	Press.bPending = false;
+	// Slide lasts while held, the others are one shot
+	if (Input != INPUT_Slide) Press.bHeld = false;
 }
 
 void USurvivalCharacterMovementComponent::StartClimb()
@@ -1592,26 +2774,44 @@ void USurvivalCharacterMovementComponent::GetLifetimeReplicatedProps(TArray<FLif
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME_CONDITION(USurvivalCharacterMovementComponent, Proxy_bDash, COND_SkipOwner)
-	
-	DOREPLIFETIME_CONDITION(USurvivalCharacterMovementComponent, Proxy_bShortMantle, COND_SkipOwner)
-	DOREPLIFETIME_CONDITION(USurvivalCharacterMovementComponent, Proxy_bTallMantle, COND_SkipOwner)
+	DOREPLIFETIME_CONDITION(USurvivalCharacterMovementComponent, Proxy_bWallRunIsRight, COND_SkipOwner)
 }
 
-void USurvivalCharacterMovementComponent::OnRep_Dash()
+void USurvivalCharacterMovementComponent::Multicast_CosmeticEvents_Implementation(uint8 Events)
 {
-	CharacterOwner->PlayAnimMontage(DashMontage);
-    DashStartDelegate.Broadcast();
+	// The owner and the server already played these
+	if (GetOwnerRole() != ROLE_SimulatedProxy || !CharacterOwner) return;
+
+	if (Events & COSMETIC_Dash) DashStartDelegate.Broadcast();
+
+	// Proxies past ProxyLowDetailDistance skip the montages entirely
+	if (bProxyLowDetail) return;
+
+	if (Events & COSMETIC_Dash) CharacterOwner->PlayAnimMontage(DashMontage);
+	if (Events & COSMETIC_ShortMantle) CharacterOwner->PlayAnimMontage(ProxyShortMantleMontage);
+	if (Events & COSMETIC_TallMantle) CharacterOwner->PlayAnimMontage(ProxyTallMantleMontage);
 }
 
-void USurvivalCharacterMovementComponent::OnRep_ShortMantle()
+#if SURVIVAL_MOVEMENT_DEBUG
+void USurvivalCharacterMovementComponent::GetDebugLines(TArray<FString>& OutLines) const
 {
-	CharacterOwner->PlayAnimMontage(ProxyShortMantleMontage);
+	const UEnum* TransitionEnum = StaticEnum<ESurvivalTransition>();
+	OutLines.Add(FString::Printf(TEXT("%s %s"), *GetNameSafe(CharacterOwner), *GetMovementName()));
+	OutLines.Add(FString::Printf(TEXT("Speed: %.0f / %.0f cm/s"), Velocity.Size(), GetMaxSpeed()));
+	OutLines.Add(FString::Printf(TEXT("Transition: %s, queued: %s"),
+		*TransitionEnum->GetNameStringByValue(static_cast<int64>(Safe_Transition)), *TransitionEnum->GetNameStringByValue(static_cast<int64>(Safe_QueuedTransition))));
+	OutLines.Add(FString::Printf(TEXT("Ticks: %lld, corrections: %d, bits sent: %lld"), TickCount, CorrectionCount, TotalBitsSent));
+	if (IsServer())
+	{
+		OutLines.Add(FString::Printf(TEXT("Server: %d moves checked, %d corrections, %d absorbed, budget left %.2f"),
+			ServerValidationTelemetry.MovesChecked, ServerValidationTelemetry.CorrectionsSent, ServerValidationTelemetry.ErrorsAbsorbed, GetServerPositionErrorBudgetLeft()));
+	}
 }
+#endif
 
-void USurvivalCharacterMovementComponent::OnRep_TallMantle()
+void USurvivalCharacterMovementComponent::OnRep_WallRunIsRight()
 {
-	CharacterOwner->PlayAnimMontage(ProxyTallMantleMontage);
+	Safe_bWallRunIsRight = Proxy_bWallRunIsRight;
 }
 
 #pragma endregion
\ No newline at end of file
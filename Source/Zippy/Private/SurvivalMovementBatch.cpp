@@ -0,0 +1,33 @@
+#include "SurvivalMovementBatch.h"
+
+#include "SurvivalCharacterMovementComponent.h"
+
+void USurvivalMovementBatchSubsystem::Tick(float DeltaTime)
+{
+	for (int32 i = Components.Num() - 1; i >= 0; i--)
+	{
+		USurvivalCharacterMovementComponent* Component = Components[i].Get();
+		if (!Component)
+		{
+			Components.RemoveAtSwap(i);
+			continue;
+		}
+
+		Component->PrefetchProbes();
+	}
+}
+
+TStatId USurvivalMovementBatchSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USurvivalMovementBatchSubsystem, STATGROUP_Tickables);
+}
+
+void USurvivalMovementBatchSubsystem::Register(USurvivalCharacterMovementComponent* Component)
+{
+	Components.AddUnique(Component);
+}
+
+void USurvivalMovementBatchSubsystem::Unregister(USurvivalCharacterMovementComponent* Component)
+{
+	Components.RemoveSingleSwap(Component);
+}
@@ -0,0 +1,460 @@
+#include "SurvivalMovementBenchmark.h"
+
+#include "SurvivalCharacterMovementComponent.h"
+#include "ZippyCharacter.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+
+#if WITH_EDITOR && WITH_DEV_AUTOMATION_TESTS
+#include "Editor.h"
+#include "Misc/AutomationTest.h"
+#include "Settings/LevelEditorPlaySettings.h"
+#include "Tests/AutomationCommon.h"
+#include "Tests/AutomationEditorCommon.h"
+#endif
+
+#if SURVIVAL_MOVEMENT_STATS
+
+static int32 GForcedCorrectionInterval = 0;
+static FAutoConsoleVariableRef CVarForcedCorrectionInterval(
+	TEXT("zippy.Movement.Benchmark.ForceCorrectionInterval"),
+	GForcedCorrectionInterval,
+	TEXT("When above zero the server forces a correction every N checked client moves, to measure replay cost. 0 disables."),
+	ECVF_Cheat);
+
+static FAutoConsoleCommandWithWorldAndArgs CmdMovementBenchmark(
+	TEXT("zippy.Movement.Benchmark"),
+	TEXT("Runs the movement benchmark on the characters of every net client world. Usage: zippy.Movement.Benchmark [Seconds=10], or zippy.Movement.Benchmark stop"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (Args.Num() > 0 && Args[0] == TEXT("stop"))
+		{
+			USurvivalMovementBenchmarkSubsystem::StopBenchmark();
+			return;
+		}
+
+		const float Duration = Args.Num() > 0 ? FCString::Atof(*Args[0]) : 10.f;
+		USurvivalMovementBenchmarkSubsystem::StartBenchmark(Duration);
+	}),
+	ECVF_Cheat);
+
+namespace
+{
+	// One benchmark spans every client world in the process, so its bookkeeping is shared rather than per subsystem
+	bool bBenchmarkRunning = false;
+	int32 BenchmarkCharacters = 0;
+	double BenchmarkStartTime = 0.0;
+	uint64 BenchmarkStartFrame = 0;
+	SurvivalMovementStats::FTotals BenchmarkStartTotals;
+	FSurvivalMovementBenchmarkResults LastResults;
+}
+
+void FSurvivalMovementBenchmarkResults::GetLines(TArray<FString>& OutLines) const
+{
+	OutLines.Add(FString::Printf(TEXT("%d characters, %.1fs, %llu frames"), NumCharacters, Seconds, Frames));
+	OutLines.Add(FString::Printf(TEXT("PerformMovement: %lld calls, %.0f ns/call, %.2f traces/tick"), PerformMovements, NsPerMovement, TracesPerTick));
+	OutLines.Add(FString::Printf(TEXT("Server moves: %lld sent, %.1f bits/move"), ServerMovesSent, BitsPerMove));
+	OutLines.Add(FString::Printf(TEXT("Corrections: %lld sent, %lld received, %lld replays, %.0f ns/replay"), ServerCorrections, ClientCorrections, Replays, NsPerReplay));
+}
+
+#endif
+
+bool USurvivalMovementBenchmarkSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+#if SURVIVAL_MOVEMENT_STATS
+	return Super::ShouldCreateSubsystem(Outer);
+#else
+	return false;
+#endif
+}
+
+void USurvivalMovementBenchmarkSubsystem::Deinitialize()
+{
+	// A client leaving ends the run with what was measured so far
+	if (bRunning) StopBenchmark();
+
+	Super::Deinitialize();
+}
+
+TStatId USurvivalMovementBenchmarkSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USurvivalMovementBenchmarkSubsystem, STATGROUP_Tickables);
+}
+
+int32 USurvivalMovementBenchmarkSubsystem::GetForcedCorrectionInterval()
+{
+#if SURVIVAL_MOVEMENT_STATS
+	return GForcedCorrectionInterval;
+#else
+	return 0;
+#endif
+}
+
+int32 USurvivalMovementBenchmarkSubsystem::StartBenchmark(float Duration)
+{
+#if SURVIVAL_MOVEMENT_STATS
+	StopBenchmark();
+
+	int32 NumCharacters = 0;
+	for (const FWorldContext& Context : GEngine->GetWorldContexts())
+	{
+		if (USurvivalMovementBenchmarkSubsystem* Benchmark = Context.World() ? Context.World()->GetSubsystem<USurvivalMovementBenchmarkSubsystem>() : nullptr)
+		{
+			NumCharacters += Benchmark->StartDriving(Duration);
+		}
+	}
+
+	if (NumCharacters == 0)
+	{
+		UE_LOG(LogSurvivalCharacterMovement, Warning, TEXT("zippy.Movement.Benchmark: needs a net client with a possessed character, run PIE with Net Mode 'Play As Client'"));
+		return 0;
+	}
+
+	bBenchmarkRunning = true;
+	BenchmarkCharacters = NumCharacters;
+	BenchmarkStartTime = FPlatformTime::Seconds();
+	BenchmarkStartFrame = GFrameCounter;
+	BenchmarkStartTotals = SurvivalMovementStats::GetTotals();
+
+	UE_LOG(LogSurvivalCharacterMovement, Display, TEXT("zippy.Movement.Benchmark: running %d characters for %.1fs"), NumCharacters, Duration);
+	return NumCharacters;
+#else
+	return 0;
+#endif
+}
+
+void USurvivalMovementBenchmarkSubsystem::StopBenchmark()
+{
+#if SURVIVAL_MOVEMENT_STATS
+	if (!bBenchmarkRunning) return;
+	bBenchmarkRunning = false;
+
+	for (const FWorldContext& Context : GEngine->GetWorldContexts())
+	{
+		if (USurvivalMovementBenchmarkSubsystem* Benchmark = Context.World() ? Context.World()->GetSubsystem<USurvivalMovementBenchmarkSubsystem>() : nullptr)
+		{
+			Benchmark->StopDriving();
+		}
+	}
+
+	// The totals also count every other character in the process, the driven ones are the bulk of them
+	const SurvivalMovementStats::FTotals& Totals = SurvivalMovementStats::GetTotals();
+	const SurvivalMovementStats::FTotals& Start = BenchmarkStartTotals;
+
+	FSurvivalMovementBenchmarkResults& Results = LastResults;
+	Results = FSurvivalMovementBenchmarkResults();
+	Results.NumCharacters = BenchmarkCharacters;
+	Results.Seconds = FPlatformTime::Seconds() - BenchmarkStartTime;
+	Results.Frames = GFrameCounter - BenchmarkStartFrame;
+
+	Results.PerformMovements = Totals.PerformMovements - Start.PerformMovements;
+	if (Results.PerformMovements > 0)
+	{
+		Results.NsPerMovement = FPlatformTime::ToMilliseconds64(Totals.PerformMovementCycles - Start.PerformMovementCycles) * 1e6 / Results.PerformMovements;
+		Results.TracesPerTick = static_cast<double>(Totals.Traces - Start.Traces) / Results.PerformMovements;
+	}
+
+	Results.ServerMovesSent = Totals.ServerMovesSent - Start.ServerMovesSent;
+	if (Results.ServerMovesSent > 0)
+	{
+		Results.BitsPerMove = static_cast<double>(Totals.BitsSent - Start.BitsSent) / Results.ServerMovesSent;
+	}
+
+	Results.Replays = Totals.Replays - Start.Replays;
+	if (Results.Replays > 0)
+	{
+		Results.NsPerReplay = FPlatformTime::ToMilliseconds64(Totals.ReplayCycles - Start.ReplayCycles) * 1e6 / Results.Replays;
+	}
+	Results.ServerCorrections = Totals.ServerCorrections - Start.ServerCorrections;
+	Results.ClientCorrections = Totals.ClientCorrections - Start.ClientCorrections;
+
+	TArray<FString> Lines;
+	Results.GetLines(Lines);
+	for (const FString& Line : Lines)
+	{
+		UE_LOG(LogSurvivalCharacterMovement, Display, TEXT("zippy.Movement.Benchmark: %s"), *Line);
+	}
+#endif
+}
+
+bool USurvivalMovementBenchmarkSubsystem::IsBenchmarkRunning()
+{
+#if SURVIVAL_MOVEMENT_STATS
+	return bBenchmarkRunning;
+#else
+	return false;
+#endif
+}
+
+int32 USurvivalMovementBenchmarkSubsystem::GetNumDrivableCharacters()
+{
+	int32 NumCharacters = 0;
+	for (const FWorldContext& Context : GEngine->GetWorldContexts())
+	{
+		NumCharacters += FindDrivableCharacters(Context.World()).Num();
+	}
+	return NumCharacters;
+}
+
+#if SURVIVAL_MOVEMENT_STATS
+const FSurvivalMovementBenchmarkResults& USurvivalMovementBenchmarkSubsystem::GetLastResults()
+{
+	return LastResults;
+}
+#endif
+
+TArray<AZippyCharacter*> USurvivalMovementBenchmarkSubsystem::FindDrivableCharacters(const UWorld* World)
+{
+	TArray<AZippyCharacter*> Result;
+	if (!World || !World->IsGameWorld() || World->GetNetMode() != NM_Client) return Result;
+
+	// Only autonomous proxies build saved moves and replay corrections, so only they are measured
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PC = It->Get();
+		AZippyCharacter* Character = PC && PC->IsLocalController() ? Cast<AZippyCharacter>(PC->GetPawn()) : nullptr;
+		if (Character && Character->GetLocalRole() == ROLE_AutonomousProxy)
+		{
+			Result.Add(Character);
+		}
+	}
+	return Result;
+}
+
+int32 USurvivalMovementBenchmarkSubsystem::StartDriving(float Duration)
+{
+	for (AZippyCharacter* Character : FindDrivableCharacters(GetWorld()))
+	{
+		Characters.Add(Character);
+		CharacterSteps.Add(Step_Num);
+	}
+
+	bRunning = Characters.Num() > 0;
+	ElapsedTime = 0.f;
+	BenchmarkDuration = Duration;
+	return Characters.Num();
+}
+
+void USurvivalMovementBenchmarkSubsystem::StopDriving()
+{
+	for (const TWeakObjectPtr<AZippyCharacter>& Character : Characters)
+	{
+		USurvivalCharacterMovementComponent* Movement = Character.IsValid() ? Character->GetZippyCharacterMovement() : nullptr;
+		if (!Movement) continue;
+
+		Movement->StopSprint();
+		Movement->StopSlide();
+		Movement->StopDash();
+		Movement->StopClimb();
+		Character->StopJumping();
+	}
+
+	Characters.Reset();
+	CharacterSteps.Reset();
+	bRunning = false;
+}
+
+void USurvivalMovementBenchmarkSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	ElapsedTime += DeltaTime;
+	if (ElapsedTime >= BenchmarkDuration)
+	{
+		StopBenchmark();
+		return;
+	}
+
+	for (int32 i = 0; i < Characters.Num(); i++)
+	{
+		AZippyCharacter* Character = Characters[i].Get();
+		if (!Character) continue;
+
+		// Offset each character so they do not all switch steps on the same frame
+		const float ScriptTime = ElapsedTime + i * 0.37f;
+		const EScriptStep Step = static_cast<EScriptStep>(FMath::FloorToInt32(ScriptTime / StepDuration) % Step_Num);
+		const bool bStepStarted = CharacterSteps[i] != Step;
+		CharacterSteps[i] = Step;
+
+		DriveCharacter(Character, Step, bStepStarted);
+	}
+}
+
+void USurvivalMovementBenchmarkSubsystem::DriveCharacter(AZippyCharacter* Character, EScriptStep Step, bool bStepStarted) const
+{
+	USurvivalCharacterMovementComponent* Movement = Character->GetZippyCharacterMovement();
+	if (!Movement) return;
+
+	// Release whatever the previous step was holding
+	if (bStepStarted)
+	{
+		Movement->StopSprint();
+		Movement->StopSlide();
+		Movement->StopDash();
+		Movement->StopClimb();
+		Character->StopJumping();
+	}
+
+	// Pending input is consumed by the next movement tick, which saves the move and sends it with ReplicateMoveToServer
+	Character->AddMovementInput(Character->GetActorForwardVector());
+
+	switch (Step)
+	{
+	case Step_Sprint:
+		if (bStepStarted) Movement->StartSprint();
+		break;
+	case Step_Slide:
+		if (bStepStarted)
+		{
+			Movement->StartSprint();
+			Movement->StartSlide();
+		}
+		break;
+	case Step_Dash:
+		if (bStepStarted) Movement->StartDash();
+		break;
+	case Step_Mantle:
+		if (bStepStarted) Character->Jump();
+		break;
+	case Step_WallRun:
+		Character->AddMovementInput(Character->GetActorRightVector());
+		if (bStepStarted)
+		{
+			Movement->StartSprint();
+			Character->Jump();
+		}
+		break;
+	case Step_Climb:
+		if (bStepStarted) Character->Jump();
+		else Movement->StartClimb();
+		break;
+	default:
+		break;
+	}
+}
+
+#if WITH_EDITOR && WITH_DEV_AUTOMATION_TESTS && SURVIVAL_MOVEMENT_STATS
+
+static FString GBenchmarkMap = TEXT("/Game/ThirdPerson/Maps/ThirdPersonMap");
+static FAutoConsoleVariableRef CVarBenchmarkMap(
+	TEXT("zippy.Movement.Benchmark.Map"),
+	GBenchmarkMap,
+	TEXT("The map the Zippy.Movement.Benchmark automation test runs on. Keep it fixed so runs stay comparable."));
+
+static int32 GBenchmarkClients = 4;
+static FAutoConsoleVariableRef CVarBenchmarkClients(
+	TEXT("zippy.Movement.Benchmark.Clients"),
+	GBenchmarkClients,
+	TEXT("How many PIE net clients the Zippy.Movement.Benchmark automation test connects, one character each."));
+
+static float GBenchmarkSeconds = 20.f;
+static FAutoConsoleVariableRef CVarBenchmarkSeconds(
+	TEXT("zippy.Movement.Benchmark.Seconds"),
+	GBenchmarkSeconds,
+	TEXT("How long the Zippy.Movement.Benchmark automation test drives the characters for."));
+
+static int32 GBenchmarkCorrectionInterval = 30;
+static FAutoConsoleVariableRef CVarBenchmarkCorrectionInterval(
+	TEXT("zippy.Movement.Benchmark.TestCorrectionInterval"),
+	GBenchmarkCorrectionInterval,
+	TEXT("The forced correction interval the Zippy.Movement.Benchmark automation test runs with."));
+
+/** Starts PIE with a dedicated server and the benchmark's net clients in this process. */
+DEFINE_LATENT_AUTOMATION_COMMAND_ONE_PARAMETER(FStartSurvivalMovementBenchmarkPIECommand, int32, NumClients);
+bool FStartSurvivalMovementBenchmarkPIECommand::Update()
+{
+	ULevelEditorPlaySettings* PlaySettings = NewObject<ULevelEditorPlaySettings>();
+	PlaySettings->SetPlayNetMode(EPlayNetMode::PIE_Client);
+	PlaySettings->SetPlayNumberOfClients(NumClients);
+	PlaySettings->SetRunUnderOneProcess(true);
+
+	FRequestPlaySessionParams Params;
+	Params.WorldType = EPlaySessionWorldType::PlayInEditor;
+	Params.EditorPlaySettings = PlaySettings;
+	GEditor->RequestPlaySession(Params);
+	return true;
+}
+
+/** Waits for every client to be possessing its character, then starts the benchmark. */
+class FStartSurvivalMovementBenchmarkCommand : public IAutomationLatentCommand
+{
+public:
+	FStartSurvivalMovementBenchmarkCommand(FAutomationTestBase* InTest, int32 InNumClients, float InSeconds)
+		: Test(InTest), NumClients(InNumClients), Seconds(InSeconds)
+	{
+	}
+
+	virtual bool Update() override
+	{
+		if (USurvivalMovementBenchmarkSubsystem::GetNumDrivableCharacters() < NumClients)
+		{
+			if (GetCurrentRunTime() < 30.0) return false;
+
+			Test->AddError(FString::Printf(TEXT("Only %d of %d clients possessed a character"), USurvivalMovementBenchmarkSubsystem::GetNumDrivableCharacters(), NumClients));
+			return true;
+		}
+
+		USurvivalMovementBenchmarkSubsystem::StartBenchmark(Seconds);
+		return true;
+	}
+
+private:
+	FAutomationTestBase* Test;
+	int32 NumClients;
+	float Seconds;
+};
+
+/** Waits for the benchmark to stop on its own, then reports its results. */
+class FReportSurvivalMovementBenchmarkCommand : public IAutomationLatentCommand
+{
+public:
+	FReportSurvivalMovementBenchmarkCommand(FAutomationTestBase* InTest, int32 InPreviousCorrectionInterval)
+		: Test(InTest), PreviousCorrectionInterval(InPreviousCorrectionInterval)
+	{
+	}
+
+	virtual bool Update() override
+	{
+		if (USurvivalMovementBenchmarkSubsystem::IsBenchmarkRunning()) return false;
+
+		GForcedCorrectionInterval = PreviousCorrectionInterval;
+
+		const FSurvivalMovementBenchmarkResults& Results = USurvivalMovementBenchmarkSubsystem::GetLastResults();
+		if (Results.ServerMovesSent == 0)
+		{
+			Test->AddError(TEXT("No client moves reached the server"));
+		}
+
+		TArray<FString> Lines;
+		Results.GetLines(Lines);
+		for (const FString& Line : Lines)
+		{
+			Test->AddInfo(Line);
+		}
+		return true;
+	}
+
+private:
+	FAutomationTestBase* Test;
+	int32 PreviousCorrectionInterval;
+};
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSurvivalMovementBenchmarkTest, "Zippy.Movement.Benchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FSurvivalMovementBenchmarkTest::RunTest(const FString& Parameters)
+{
+	FAutomationEditorCommonUtils::LoadMap(GBenchmarkMap);
+
+	const int32 PreviousCorrectionInterval = GForcedCorrectionInterval;
+	GForcedCorrectionInterval = GBenchmarkCorrectionInterval;
+
+	ADD_LATENT_AUTOMATION_COMMAND(FStartSurvivalMovementBenchmarkPIECommand(GBenchmarkClients));
+	ADD_LATENT_AUTOMATION_COMMAND(FStartSurvivalMovementBenchmarkCommand(this, GBenchmarkClients, GBenchmarkSeconds));
+	ADD_LATENT_AUTOMATION_COMMAND(FReportSurvivalMovementBenchmarkCommand(this, PreviousCorrectionInterval));
+	ADD_LATENT_AUTOMATION_COMMAND(FEndPlayMapCommand());
+	return true;
+}
+
+#endif
@@ -0,0 +1,167 @@
+#include "SurvivalMovementCapture.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/Paths.h"
+
+static int32 GSurvivalMovementCapture = 0;
+static FAutoConsoleVariableRef CVarSurvivalMovementCapture(
+	TEXT("zippy.Movement.Capture"),
+	GSurvivalMovementCapture,
+	TEXT("Captures the local player's moves and corrections to Saved/MovementCaptures for offline replay. Read when the character begins play."),
+	ECVF_Default);
+
+static float GSurvivalMovementCaptureSampleRate = 1.f;
+static FAutoConsoleVariableRef CVarSurvivalMovementCaptureSampleRate(
+	TEXT("zippy.Movement.CaptureSampleRate"),
+	GSurvivalMovementCaptureSampleRate,
+	TEXT("Fraction of sessions captured while zippy.Movement.Capture is set."),
+	ECVF_Default);
+
+static int32 GSurvivalMovementCaptureMaxMB = 16;
+static FAutoConsoleVariableRef CVarSurvivalMovementCaptureMaxMB(
+	TEXT("zippy.Movement.CaptureMaxMB"),
+	GSurvivalMovementCaptureMaxMB,
+	TEXT("Size in MB a movement capture file wraps at, keeping the most recent moves."),
+	ECVF_Default);
+
+// How long the writer thread sleeps between drains.
+static constexpr float CaptureDrainInterval = .05f;
+
+bool SurvivalMovementCapture::ShouldCaptureSession()
+{
+	return GSurvivalMovementCapture != 0 && FMath::FRand() < GSurvivalMovementCaptureSampleRate;
+}
+
+int64 SurvivalMovementCapture::GetMaxBytes()
+{
+	return FMath::Max<int64>(GSurvivalMovementCaptureMaxMB, 1) * 1024 * 1024;
+}
+
+FSurvivalMovementCaptureWriter::FSurvivalMovementCaptureWriter(const FString& Filename, const FString& MapName, int64 MaxBytes)
+: Queue(QueueCapacity)
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*FPaths::GetPath(Filename));
+	File.Reset(PlatformFile.OpenWrite(*Filename));
+	if (!File) return;
+
+	FCStringAnsi::Strncpy(Header.MapName, TCHAR_TO_ANSI(*MapName), UE_ARRAY_COUNT(Header.MapName));
+	File->Write(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+
+	MaxRecordBytes = FMath::Max<int64>(MaxBytes - sizeof(Header), sizeof(FSurvivalMoveCaptureRecord));
+	Thread = FRunnableThread::Create(this, TEXT("SurvivalMovementCapture"), 0, TPri_BelowNormal);
+}
+
+FSurvivalMovementCaptureWriter::~FSurvivalMovementCaptureWriter()
+{
+	if (Thread)
+	{
+		Thread->Kill(true);
+		delete Thread;
+	}
+	if (File)
+	{
+		// Drain first so the held record finds room in the queue
+		Drain();
+		if (HeldRecord)
+		{
+			Enqueue(*HeldRecord);
+			Drain();
+		}
+
+		Header.Dropped = Dropped;
+		File->Seek(0);
+		File->Write(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+		File->Flush();
+	}
+}
+
+void FSurvivalMovementCaptureWriter::Push(const FSurvivalMoveCaptureRecord& Record, bool bSupersedesLastMove)
+{
+	if (HeldRecord && !(bSupersedesLastMove && HeldRecord->Type == FSurvivalMoveCaptureRecord::Type_Move))
+	{
+		Enqueue(*HeldRecord);
+	}
+	HeldRecord = Record;
+}
+
+void FSurvivalMovementCaptureWriter::Enqueue(FSurvivalMoveCaptureRecord& Record)
+{
+	Record.Sequence = NextSequence++;
+	if (!File || !Queue.Enqueue(Record)) Dropped++;
+}
+
+uint32 FSurvivalMovementCaptureWriter::Run()
+{
+	while (!bStopping)
+	{
+		Drain();
+		FPlatformProcess::Sleep(CaptureDrainInterval);
+	}
+	return 0;
+}
+
+void FSurvivalMovementCaptureWriter::Drain()
+{
+	// Batch the records into one write
+	FSurvivalMoveCaptureRecord Batch[64];
+	int32 Num = 0;
+	auto Flush = [&]()
+	{
+		const int64 BatchBytes = Num * sizeof(FSurvivalMoveCaptureRecord);
+		if (WriteOffset + BatchBytes > MaxRecordBytes)
+		{
+			// Wrap, splitting the batch at the end of the ring
+			const int32 NumBeforeWrap = (MaxRecordBytes - WriteOffset) / sizeof(FSurvivalMoveCaptureRecord);
+			File->Seek(sizeof(FSurvivalMoveCaptureHeader) + WriteOffset);
+			File->Write(reinterpret_cast<const uint8*>(Batch), NumBeforeWrap * sizeof(FSurvivalMoveCaptureRecord));
+			File->Seek(sizeof(FSurvivalMoveCaptureHeader));
+			File->Write(reinterpret_cast<const uint8*>(Batch + NumBeforeWrap), (Num - NumBeforeWrap) * sizeof(FSurvivalMoveCaptureRecord));
+			WriteOffset = (Num - NumBeforeWrap) * sizeof(FSurvivalMoveCaptureRecord);
+		}
+		else
+		{
+			File->Seek(sizeof(FSurvivalMoveCaptureHeader) + WriteOffset);
+			File->Write(reinterpret_cast<const uint8*>(Batch), BatchBytes);
+			WriteOffset += BatchBytes;
+		}
+		Num = 0;
+	};
+
+	while (Queue.Dequeue(Batch[Num]))
+	{
+		if (++Num == UE_ARRAY_COUNT(Batch)) Flush();
+	}
+	if (Num > 0) Flush();
+}
+
+bool FSurvivalMovementCaptureWriter::ReadCapture(const FString& Filename, FSurvivalMoveCaptureHeader& OutHeader, TArray<FSurvivalMoveCaptureRecord>& OutRecords)
+{
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Filename));
+	if (!Reader || Reader->TotalSize() < (int64)sizeof(FSurvivalMoveCaptureHeader)) return false;
+
+	Reader->Serialize(&OutHeader, sizeof(OutHeader));
+	if (OutHeader.Magic != FSurvivalMoveCaptureHeader::CaptureMagic
+		|| OutHeader.Version != FSurvivalMoveCaptureHeader::CaptureVersion
+		|| OutHeader.RecordSize != sizeof(FSurvivalMoveCaptureRecord))
+	{
+		return false;
+	}
+	OutHeader.MapName[UE_ARRAY_COUNT(OutHeader.MapName) - 1] = 0;
+
+	const int64 NumRecords = (Reader->TotalSize() - sizeof(FSurvivalMoveCaptureHeader)) / sizeof(FSurvivalMoveCaptureRecord);
+	OutRecords.SetNumUninitialized(NumRecords);
+	Reader->Serialize(OutRecords.GetData(), NumRecords * sizeof(FSurvivalMoveCaptureRecord));
+
+	OutRecords.Sort([](const FSurvivalMoveCaptureRecord& A, const FSurvivalMoveCaptureRecord& B) { return A.Sequence < B.Sequence; });
+	return true;
+}
+
+FString FSurvivalMovementCaptureWriter::GetCaptureDir()
+{
+	return FPaths::ProjectSavedDir() / TEXT("MovementCaptures");
+}
@@ -0,0 +1,33 @@
+#include "SurvivalMovementCurve.h"
+
+#include "Curves/CurveFloat.h"
+
+void FSurvivalBakedCurve::Bake(const UCurveFloat* Curve, float DefaultValue)
+{
+	MinTime = 0.f;
+	SamplesPerTime = 0.f;
+	bFromCurve = Curve && Curve->FloatCurve.GetNumKeys() > 0;
+
+	if (!bFromCurve)
+	{
+		for (float& Value : Samples)
+		{
+			Value = DefaultValue;
+		}
+		return;
+	}
+
+	float MaxTime = 0.f;
+	Curve->GetTimeRange(MinTime, MaxTime);
+
+	const float Range = MaxTime - MinTime;
+	if (Range > UE_KINDA_SMALL_NUMBER)
+	{
+		SamplesPerTime = (NumSamples - 1) / Range;
+	}
+
+	for (int32 i = 0; i < NumSamples; i++)
+	{
+		Samples[i] = Curve->GetFloatValue(SamplesPerTime > 0.f ? MinTime + i / SamplesPerTime : MinTime);
+	}
+}
@@ -0,0 +1,84 @@
+#include "SurvivalMovementDebug.h"
+
+#include "SurvivalCharacterMovementComponent.h"
+#include "ZippyCharacter.h"
+#include "DrawDebugHelpers.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+
+#if SURVIVAL_MOVEMENT_DEBUG
+
+static int32 GSurvivalMovementDebugLevel = SurvivalMovementDebug::Level_Off;
+static FAutoConsoleVariableRef CVarSurvivalMovementDebug(
+	TEXT("zippy.Movement.Debug"),
+	GSurvivalMovementDebugLevel,
+	TEXT("Draws survival movement debugging for the viewed character. 0: off, 1: mantle, hang and wall probes, 2: probes plus movement and network stats."),
+	ECVF_Cheat);
+
+#endif
+
+int32 SurvivalMovementDebug::GetLevel()
+{
+#if SURVIVAL_MOVEMENT_DEBUG
+	return GSurvivalMovementDebugLevel;
+#else
+	return Level_Off;
+#endif
+}
+
+bool SurvivalMovementDebug::ShouldDraw(const AActor* Character)
+{
+#if SURVIVAL_MOVEMENT_DEBUG
+	if (GSurvivalMovementDebugLevel <= Level_Off || !Character) return false;
+
+	const UWorld* World = Character->GetWorld();
+	const APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+	return PC && PC->GetViewTarget() == Character;
+#else
+	return false;
+#endif
+}
+
+bool USurvivalMovementDebugSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+#if SURVIVAL_MOVEMENT_DEBUG
+	return Super::ShouldCreateSubsystem(Outer);
+#else
+	return false;
+#endif
+}
+
+bool USurvivalMovementDebugSubsystem::IsTickable() const
+{
+	return SurvivalMovementDebug::GetLevel() >= SurvivalMovementDebug::Level_NetStats;
+}
+
+TStatId USurvivalMovementDebugSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USurvivalMovementDebugSubsystem, STATGROUP_Tickables);
+}
+
+void USurvivalMovementDebugSubsystem::Tick(float DeltaTime)
+{
+#if SURVIVAL_MOVEMENT_DEBUG
+	const APlayerController* PC = GetWorld()->GetFirstPlayerController();
+	const AZippyCharacter* Character = PC ? Cast<AZippyCharacter>(PC->GetViewTarget()) : nullptr;
+	const USurvivalCharacterMovementComponent* Movement = Character ? Character->GetZippyCharacterMovement() : nullptr;
+	if (!Movement || !GEngine) return;
+
+	const FVector Location = Character->GetActorLocation();
+	DrawDebugDirectionalArrow(GetWorld(), Location, Location + Movement->Velocity * .2f, 20.f, FColor::Cyan, false, -1.f, 0, 2.f);
+
+	TArray<FString> Lines;
+	Movement->GetDebugLines(Lines);
+
+	// Fixed keys replace last frame's lines instead of stacking new ones
+	const uint64 BaseKey = reinterpret_cast<uint64>(this);
+	for (int32 i = 0; i < Lines.Num(); i++)
+	{
+		GEngine->AddOnScreenDebugMessage(BaseKey + i, 0.f, FColor::Yellow, Lines[i]);
+	}
+#endif
+}
@@ -0,0 +1,155 @@
+#include "SurvivalMovementReplayCommandlet.h"
+
+#include "SurvivalCharacterMovementComponent.h"
+#include "SurvivalMovementCapture.h"
+#include "ZippyCharacter.h"
+#include "Engine/World.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Parse.h"
+#include "UObject/Package.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSurvivalMovementReplay, Log, All);
+
+USurvivalMovementReplayCommandlet::USurvivalMovementReplayCommandlet()
+{
+	IsClient = false;
+	IsServer = true;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 USurvivalMovementReplayCommandlet::Main(const FString& Params)
+{
+	FString CaptureFile;
+	if (!FParse::Value(*Params, TEXT("Capture="), CaptureFile))
+	{
+		UE_LOG(LogSurvivalMovementReplay, Error, TEXT("Missing -Capture=<file>"));
+		return 1;
+	}
+	float Tolerance = 1.f;
+	FParse::Value(*Params, TEXT("Tolerance="), Tolerance);
+
+	FSurvivalMoveCaptureHeader Header;
+	TArray<FSurvivalMoveCaptureRecord> Records;
+	if (!FSurvivalMovementCaptureWriter::ReadCapture(CaptureFile, Header, Records))
+	{
+		UE_LOG(LogSurvivalMovementReplay, Error, TEXT("Could not read capture %s"), *CaptureFile);
+		return 1;
+	}
+
+	UE_CLOG(Header.Dropped > 0, LogSurvivalMovementReplay, Warning, TEXT("Capture dropped %u records while writing, the replay has gaps"), Header.Dropped);
+
+	// World
+	const FString MapName = ANSI_TO_TCHAR(Header.MapName);
+	UPackage* MapPackage = LoadPackage(nullptr, *MapName, LOAD_None);
+	UWorld* World = MapPackage ? UWorld::FindWorldInPackage(MapPackage) : nullptr;
+	if (!World)
+	{
+		UE_LOG(LogSurvivalMovementReplay, Error, TEXT("Could not load map %s"), *MapName);
+		return 1;
+	}
+	World->AddToRoot();
+	World->WorldType = EWorldType::Game;
+	if (!World->bIsWorldInitialized)
+	{
+		World->InitWorld(UWorld::InitializationValues()
+			.AllowAudioPlayback(false)
+			.CreatePhysicsScene(true)
+			.RequiresHitProxies(false)
+			.CreateNavigation(false)
+			.CreateAISystem(false)
+			.ShouldSimulatePhysics(false)
+			.SetTransactional(false));
+	}
+	World->UpdateWorldComponents(true, false);
+	World->InitializeActorsForPlay(FURL());
+
+	// Character, spawned where the first move started
+	UClass* CharacterClass = AZippyCharacter::StaticClass();
+	FString CharacterClassPath;
+	if (FParse::Value(*Params, TEXT("Character="), CharacterClassPath))
+	{
+		CharacterClass = LoadClass<AZippyCharacter>(nullptr, *CharacterClassPath);
+		if (!CharacterClass)
+		{
+			UE_LOG(LogSurvivalMovementReplay, Error, TEXT("Could not load character class %s"), *CharacterClassPath);
+			return 1;
+		}
+	}
+	const FSurvivalMoveCaptureRecord* FirstMove = Records.FindByPredicate([](const FSurvivalMoveCaptureRecord& Record) { return Record.Type == FSurvivalMoveCaptureRecord::Type_Move; });
+	if (!FirstMove)
+	{
+		UE_LOG(LogSurvivalMovementReplay, Error, TEXT("Capture %s holds no moves"), *CaptureFile);
+		return 1;
+	}
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	AZippyCharacter* Character = World->SpawnActor<AZippyCharacter>(CharacterClass, FVector(FirstMove->Location), FRotator(FirstMove->Rotation), SpawnParams);
+	USurvivalCharacterMovementComponent* Movement = Character ? Character->GetZippyCharacterMovement() : nullptr;
+	if (!Movement)
+	{
+		UE_LOG(LogSurvivalMovementReplay, Error, TEXT("Could not spawn %s"), *GetNameSafe(CharacterClass));
+		return 1;
+	}
+	Movement->Velocity = FVector(FirstMove->Velocity);
+	Movement->ApplyNetworkMovementMode(FirstMove->StartPackedMode);
+
+	// Movement only runs with a controller, which also carries the captured control rotation
+	Character->SpawnDefaultController();
+	if (!Character->GetController()) Movement->bRunPhysicsWithNoController = true;
+
+	// Replay
+	int32 NumMoves = 0, NumCorrections = 0, NumDiverged = 0;
+	uint64 TotalCycles = 0, MaxCycles = 0;
+	double TotalError = 0.;
+	float MaxError = 0.f, MaxErrorTimeStamp = 0.f;
+	for (const FSurvivalMoveCaptureRecord& Record : Records)
+	{
+		if (Record.Type == FSurvivalMoveCaptureRecord::Type_Correction)
+		{
+			Character->SetActorLocationAndRotation(FVector(Record.Location), FRotator(Record.Rotation), false, nullptr, ETeleportType::TeleportPhysics);
+			Movement->Velocity = FVector(Record.Velocity);
+			Movement->ApplyNetworkMovementMode(Record.EndPackedMode);
+			NumCorrections++;
+			continue;
+		}
+
+		// Ticking the world would move the character a second time, only its clocks are advanced so time gates still run
+		World->TimeSeconds += Record.DeltaTime;
+		World->UnpausedTimeSeconds += Record.DeltaTime;
+		World->RealTimeSeconds += Record.DeltaTime;
+		World->DeltaTimeSeconds = Record.DeltaTime;
+		GFrameCounter++;
+
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		Movement->ReplayCapturedMove(Record);
+		const uint64 Cycles = FPlatformTime::Cycles64() - StartCycles;
+		TotalCycles += Cycles;
+		MaxCycles = FMath::Max(MaxCycles, Cycles);
+
+		const float Error = FVector::Dist(Character->GetActorLocation(), FVector(Record.EndLocation));
+		TotalError += Error;
+		if (Error > Tolerance)
+		{
+			if (NumDiverged == 0) UE_LOG(LogSurvivalMovementReplay, Display, TEXT("First divergence at %.3f: %.2f cm"), Record.TimeStamp, Error);
+			NumDiverged++;
+		}
+		if (Error > MaxError)
+		{
+			MaxError = Error;
+			MaxErrorTimeStamp = Record.TimeStamp;
+		}
+		NumMoves++;
+	}
+
+	const double TotalMs = FPlatformTime::ToMilliseconds64(TotalCycles);
+	UE_LOG(LogSurvivalMovementReplay, Display, TEXT("Replayed %s on %s"), *CaptureFile, *MapName);
+	UE_LOG(LogSurvivalMovementReplay, Display, TEXT("Moves: %d, captured corrections: %d, dropped while capturing: %u"), NumMoves, NumCorrections, Header.Dropped);
+	UE_LOG(LogSurvivalMovementReplay, Display, TEXT("CPU: %.3f ms total, %.2f us per move, %.2f us worst"),
+		TotalMs, NumMoves > 0 ? 1000. * TotalMs / NumMoves : 0., FPlatformTime::ToMilliseconds64(MaxCycles) * 1000.);
+	UE_LOG(LogSurvivalMovementReplay, Display, TEXT("Divergence: %d moves over %.2f cm, %.2f cm mean, %.2f cm worst at %.3f"),
+		NumDiverged, Tolerance, NumMoves > 0 ? TotalError / NumMoves : 0., MaxError, MaxErrorTimeStamp);
+
+	World->RemoveFromRoot();
+	return 0;
+}
@@ -0,0 +1,33 @@
+#include "SurvivalMovementSignificance.h"
+
+#include "SignificanceManager.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+
+const FName USurvivalMovementSignificanceSubsystem::SignificanceTag(TEXT("SurvivalMovement"));
+
+void USurvivalMovementSignificanceSubsystem::Tick(float DeltaTime)
+{
+	UWorld* World = GetWorld();
+	USignificanceManager* SignificanceManager = USignificanceManager::Get(World);
+	if (!SignificanceManager) return;
+
+	Viewpoints.Reset();
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PC = It->Get();
+		if (!PC) continue;
+
+		FVector ViewLocation;
+		FRotator ViewRotation;
+		PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+		Viewpoints.Emplace(ViewRotation, ViewLocation);
+	}
+
+	SignificanceManager->Update(Viewpoints);
+}
+
+TStatId USurvivalMovementSignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USurvivalMovementSignificanceSubsystem, STATGROUP_Tickables);
+}
@@ -0,0 +1,209 @@
+#include "SurvivalMovementStats.h"
+
+#if SURVIVAL_MOVEMENT_STATS
+
+#include "SurvivalCharacterMovementComponent.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/DelayedAutoRegister.h"
+#include "ProfilingDebugging/CountersTrace.h"
+
+DEFINE_STAT(STAT_SurvivalMovement_PhysSlide);
+DEFINE_STAT(STAT_SurvivalMovement_PhysProne);
+DEFINE_STAT(STAT_SurvivalMovement_PhysWallRun);
+DEFINE_STAT(STAT_SurvivalMovement_PhysClimb);
+DEFINE_STAT(STAT_SurvivalMovement_TryMantle);
+DEFINE_STAT(STAT_SurvivalMovement_TryHang);
+DEFINE_STAT(STAT_SurvivalMovement_CallServerMovePacked);
+
+CSV_DEFINE_CATEGORY(SurvivalMovement, true);
+
+// Every counted mode, used to stamp out the per-mode stats below.
+#define SURVIVAL_STAT_MODES(X) X(Walking) X(Falling) X(Slide) X(Prone) X(WallRun) X(Hang) X(Climb) X(Other)
+
+#define SURVIVAL_DECLARE_TRACE_STATS(Mode) \
+	DECLARE_DWORD_COUNTER_STAT(TEXT("Traces: " #Mode), STAT_SurvivalMovement_Traces_##Mode, STATGROUP_SurvivalMovement); \
+	TRACE_DECLARE_INT_COUNTER(SurvivalMovement_Traces_##Mode, TEXT("SurvivalMovement/Traces/" #Mode));
+SURVIVAL_STAT_MODES(SURVIVAL_DECLARE_TRACE_STATS)
+#undef SURVIVAL_DECLARE_TRACE_STATS
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Server Moves Checked"), STAT_SurvivalMovement_ServerMoves, STATGROUP_SurvivalMovement);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Server Corrections"), STAT_SurvivalMovement_ServerCorrections, STATGROUP_SurvivalMovement);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Server Correction Rate %"), STAT_SurvivalMovement_ServerCorrectionRate, STATGROUP_SurvivalMovement);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Client Location Error (cm)"), STAT_SurvivalMovement_LocationError, STATGROUP_SurvivalMovement);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Client Corrections"), STAT_SurvivalMovement_ClientCorrections, STATGROUP_SurvivalMovement);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Server Move Bits Sent"), STAT_SurvivalMovement_BitsSent, STATGROUP_SurvivalMovement);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Bits Per Server Move"), STAT_SurvivalMovement_BitsPerMove, STATGROUP_SurvivalMovement);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Scratch Allocations Avoided"), STAT_SurvivalMovement_ScratchReused, STATGROUP_SurvivalMovement);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Scratch Allocations"), STAT_SurvivalMovement_ScratchGrown, STATGROUP_SurvivalMovement);
+
+TRACE_DECLARE_INT_COUNTER(SurvivalMovement_ServerMoves, TEXT("SurvivalMovement/ServerMoves"));
+TRACE_DECLARE_INT_COUNTER(SurvivalMovement_ServerCorrections, TEXT("SurvivalMovement/ServerCorrections"));
+TRACE_DECLARE_FLOAT_COUNTER(SurvivalMovement_ServerCorrectionRate, TEXT("SurvivalMovement/ServerCorrectionRate"));
+TRACE_DECLARE_INT_COUNTER(SurvivalMovement_ClientCorrections, TEXT("SurvivalMovement/ClientCorrections"));
+TRACE_DECLARE_INT_COUNTER(SurvivalMovement_BitsSent, TEXT("SurvivalMovement/BitsSent"));
+TRACE_DECLARE_FLOAT_COUNTER(SurvivalMovement_BitsPerMove, TEXT("SurvivalMovement/BitsPerMove"));
+TRACE_DECLARE_INT_COUNTER(SurvivalMovement_ScratchReused, TEXT("SurvivalMovement/ScratchReused"));
+TRACE_DECLARE_INT_COUNTER(SurvivalMovement_ScratchGrown, TEXT("SurvivalMovement/ScratchGrown"));
+
+namespace SurvivalMovementStats
+{
+	namespace
+	{
+		int32 TraceCounts[Mode_Num] = {};
+		int32 ServerMoves = 0;
+		int32 ServerCorrections = 0;
+		float LocationError = 0.f;
+		int32 ClientCorrections = 0;
+		int32 BitsSent = 0;
+		int32 ServerMovesSent = 0;
+		int32 ScratchReused = 0;
+		int32 ScratchGrown = 0;
+		FTotals Totals;
+
+		// Publish once at the end of every engine frame, after every world and component has ticked
+		FDelayedAutoRegisterHelper FlushFrameRegistration(EDelayedRegisterRunPhase::EndOfEngineInit, []()
+		{
+			FCoreDelegates::OnEndFrame.AddStatic(&FlushFrame);
+		});
+	}
+
+	EMode GetMode(uint8 MovementMode, uint8 CustomMovementMode)
+	{
+		switch (MovementMode)
+		{
+		case MOVE_Walking:
+		case MOVE_NavWalking:
+			return Mode_Walking;
+		case MOVE_Falling:
+			return Mode_Falling;
+		case MOVE_Custom:
+			switch (CustomMovementMode)
+			{
+			case CMOVE_Slide: return Mode_Slide;
+			case CMOVE_Prone: return Mode_Prone;
+			case CMOVE_WallRun: return Mode_WallRun;
+			case CMOVE_Hang: return Mode_Hang;
+			case CMOVE_Climb: return Mode_Climb;
+			default: return Mode_Other;
+			}
+		default:
+			return Mode_Other;
+		}
+	}
+
+	void CountTraces(EMode Mode, int32 Count)
+	{
+		check(IsInGameThread());
+		TraceCounts[Mode] += Count;
+		Totals.Traces += Count;
+	}
+
+	void CountServerMoveChecked(bool bNeedsCorrection, float InLocationError)
+	{
+		check(IsInGameThread());
+		ServerMoves++;
+		ServerCorrections += bNeedsCorrection ? 1 : 0;
+		LocationError += InLocationError;
+		Totals.ServerMoves++;
+		Totals.ServerCorrections += bNeedsCorrection ? 1 : 0;
+	}
+
+	void CountClientCorrection()
+	{
+		check(IsInGameThread());
+		ClientCorrections++;
+		Totals.ClientCorrections++;
+	}
+
+	void CountServerMoveBits(int32 NumBits)
+	{
+		check(IsInGameThread());
+		BitsSent += NumBits;
+		ServerMovesSent++;
+		Totals.ServerMovesSent++;
+		Totals.BitsSent += NumBits;
+	}
+
+	void CountScratchQuery(bool bReused)
+	{
+		check(IsInGameThread());
+		(bReused ? ScratchReused : ScratchGrown)++;
+	}
+
+	void CountPerformMovement(uint64 Cycles)
+	{
+		check(IsInGameThread());
+		Totals.PerformMovementCycles += Cycles;
+		Totals.PerformMovements++;
+	}
+
+	void CountReplay(uint64 Cycles)
+	{
+		check(IsInGameThread());
+		Totals.ReplayCycles += Cycles;
+		Totals.Replays++;
+	}
+
+	const FTotals& GetTotals()
+	{
+		return Totals;
+	}
+
+	void FlushFrame()
+	{
+		check(IsInGameThread());
+
+		const float CorrectionRate = ServerMoves > 0 ? 100.f * ServerCorrections / ServerMoves : 0.f;
+		const float BitsPerMove = ServerMovesSent > 0 ? float(BitsSent) / ServerMovesSent : 0.f;
+
+#define SURVIVAL_PUBLISH_TRACE_STATS(Mode) \
+		SET_DWORD_STAT(STAT_SurvivalMovement_Traces_##Mode, TraceCounts[Mode_##Mode]); \
+		CSV_CUSTOM_STAT(SurvivalMovement, Traces_##Mode, TraceCounts[Mode_##Mode], ECsvCustomStatOp::Set); \
+		TRACE_COUNTER_SET(SurvivalMovement_Traces_##Mode, TraceCounts[Mode_##Mode]);
+		SURVIVAL_STAT_MODES(SURVIVAL_PUBLISH_TRACE_STATS)
+#undef SURVIVAL_PUBLISH_TRACE_STATS
+
+		SET_DWORD_STAT(STAT_SurvivalMovement_ServerMoves, ServerMoves);
+		SET_DWORD_STAT(STAT_SurvivalMovement_ServerCorrections, ServerCorrections);
+		SET_FLOAT_STAT(STAT_SurvivalMovement_ServerCorrectionRate, CorrectionRate);
+		SET_FLOAT_STAT(STAT_SurvivalMovement_LocationError, LocationError);
+		SET_DWORD_STAT(STAT_SurvivalMovement_ClientCorrections, ClientCorrections);
+		SET_DWORD_STAT(STAT_SurvivalMovement_BitsSent, BitsSent);
+		SET_FLOAT_STAT(STAT_SurvivalMovement_BitsPerMove, BitsPerMove);
+		SET_DWORD_STAT(STAT_SurvivalMovement_ScratchReused, ScratchReused);
+		SET_DWORD_STAT(STAT_SurvivalMovement_ScratchGrown, ScratchGrown);
+
+		CSV_CUSTOM_STAT(SurvivalMovement, ServerMoves, ServerMoves, ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(SurvivalMovement, ServerCorrections, ServerCorrections, ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(SurvivalMovement, ServerCorrectionRate, CorrectionRate, ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(SurvivalMovement, LocationError, LocationError, ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(SurvivalMovement, ClientCorrections, ClientCorrections, ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(SurvivalMovement, BitsSent, BitsSent, ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(SurvivalMovement, BitsPerMove, BitsPerMove, ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(SurvivalMovement, ScratchReused, ScratchReused, ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(SurvivalMovement, ScratchGrown, ScratchGrown, ECsvCustomStatOp::Set);
+
+		TRACE_COUNTER_SET(SurvivalMovement_ServerMoves, ServerMoves);
+		TRACE_COUNTER_SET(SurvivalMovement_ServerCorrections, ServerCorrections);
+		TRACE_COUNTER_SET(SurvivalMovement_ServerCorrectionRate, CorrectionRate);
+		TRACE_COUNTER_SET(SurvivalMovement_ClientCorrections, ClientCorrections);
+		TRACE_COUNTER_SET(SurvivalMovement_BitsSent, BitsSent);
+		TRACE_COUNTER_SET(SurvivalMovement_BitsPerMove, BitsPerMove);
+		TRACE_COUNTER_SET(SurvivalMovement_ScratchReused, ScratchReused);
+		TRACE_COUNTER_SET(SurvivalMovement_ScratchGrown, ScratchGrown);
+
+		FMemory::Memzero(TraceCounts);
+		ServerMoves = 0;
+		ServerCorrections = 0;
+		LocationError = 0.f;
+		ClientCorrections = 0;
+		BitsSent = 0;
+		ServerMovesSent = 0;
+		ScratchReused = 0;
+		ScratchGrown = 0;
+	}
+}
+
+#undef SURVIVAL_STAT_MODES
+
+#endif
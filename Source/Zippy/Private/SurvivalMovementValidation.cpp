@@ -0,0 +1,22 @@
+#include "SurvivalMovementValidation.h"
+
+#include "Engine/NetConnection.h"
+
+float& USurvivalMovementValidationSubsystem::GetPositionErrorBudget(const UNetConnection* Connection, float FullBudget)
+{
+	const TObjectKey<UNetConnection> Key(Connection);
+	if (float* Budget = PositionErrorBudgets.Find(Key)) return *Budget;
+
+	// Forget connections that have closed before tracking a new one
+	for (auto It = PositionErrorBudgets.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().ResolveObjectPtr()) It.RemoveCurrent();
+	}
+
+	return PositionErrorBudgets.Add(Key, FullBudget);
+}
+
+const float* USurvivalMovementValidationSubsystem::FindPositionErrorBudget(const UNetConnection* Connection) const
+{
+	return PositionErrorBudgets.Find(TObjectKey<UNetConnection>(Connection));
+}
@@ -9,30 +9,75 @@ AZippyCameraManager::AZippyCameraManager()
 {
 }
 
+void AZippyCameraManager::CacheCharacter(AZippyCharacter* ZippyCharacter)
+{
+	CachedCharacter = ZippyCharacter;
+	CachedMovement = ZippyCharacter->GetZippyCharacterMovement();
+
+	const float DefaultHalfHeight = ZippyCharacter->GetClass()->GetDefaultObject<ACharacter>()->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+	CrouchCapsuleOffset = FVector(0, 0, CachedMovement->GetCrouchedHalfHeight() - DefaultHalfHeight);
+
+	StateOffsets[CAMERA_Standing] = FVector::ZeroVector;
+	StateOffsets[CAMERA_Crouched] = FVector::ZeroVector;
+	StateOffsets[CAMERA_Slide] = SlideViewOffset;
+	StateOffsets[CAMERA_Prone] = ProneViewOffset;
+	StateOffsets[CAMERA_Climb] = ClimbViewOffset;
+
+	// Start settled in the current state instead of blending in from standing
+	const ECameraState State = GetCameraState();
+	BlendTarget = BlendFrom = BlendedOffset = StateOffsets[State] + (CachedMovement->IsCrouching() ? CrouchCapsuleOffset : FVector::ZeroVector);
+	CrouchBlendTime = CrouchBlendDuration;
+}
+
+AZippyCameraManager::ECameraState AZippyCameraManager::GetCameraState() const
+{
+	if (CachedMovement->IsSliding()) return CAMERA_Slide;
+	if (CachedMovement->IsProne()) return CAMERA_Prone;
+	if (CachedMovement->IsClimbing() || CachedMovement->IsHanging()) return CAMERA_Climb;
+	if (CachedMovement->IsCrouching()) return CAMERA_Crouched;
+	return CAMERA_Standing;
+}
+
 void AZippyCameraManager::UpdateViewTarget(FTViewTarget& OutVT, float DeltaTime)
 {
 	Super::UpdateViewTarget(OutVT, DeltaTime);
 
-	if (AZippyCharacter* ZippyCharacter = Cast<AZippyCharacter>(GetOwningPlayerController()->GetPawn()))
+	APawn* Pawn = GetOwningPlayerController()->GetPawn();
+	if (Pawn != CachedCharacter.Get() || !CachedCharacter.IsValid() || !CachedMovement.IsValid())
 	{
-		USurvivalCharacterMovementComponent* ZMC = ZippyCharacter->GetZippyCharacterMovement();
-		FVector TargetCrouchOffset = FVector(
-			0,
-			0,
-			ZMC->GetCrouchedHalfHeight() - ZippyCharacter->GetClass()->GetDefaultObject<ACharacter>()->GetCapsuleComponent()->GetScaledCapsuleHalfHeight()
-		);
-		FVector Offset = FMath::Lerp(FVector::ZeroVector, TargetCrouchOffset, FMath::Clamp(CrouchBlendTime / CrouchBlendDuration, 0.f, 1.f));
-
-		if (ZMC->IsCrouching())
+		AZippyCharacter* ZippyCharacter = Cast<AZippyCharacter>(Pawn);
+		if (ZippyCharacter && ZippyCharacter->GetZippyCharacterMovement())
 		{
-			CrouchBlendTime = FMath::Clamp(CrouchBlendTime + DeltaTime, 0.f, CrouchBlendDuration);
-			Offset -= TargetCrouchOffset;
+			CacheCharacter(ZippyCharacter);
 		}
 		else
 		{
-			CrouchBlendTime = FMath::Clamp(CrouchBlendTime - DeltaTime, 0.f, CrouchBlendDuration);
+			CachedCharacter.Reset();
+			CachedMovement.Reset();
+			return;
 		}
+	}
+
+	// The camera follows the capsule, which already moved by CrouchCapsuleOffset when crouched. Blend a virtual offset that
+	// includes the capsule change and subtract the real one, so the height change is smoothed instead of snapping.
+	const FVector CapsuleOffset = CachedMovement->IsCrouching() ? CrouchCapsuleOffset : FVector::ZeroVector;
+	const FVector Target = StateOffsets[GetCameraState()] + CapsuleOffset;
+	if (!Target.Equals(BlendTarget))
+	{
+		BlendFrom = BlendedOffset;
+		BlendTarget = Target;
+		CrouchBlendTime = 0.f;
+	}
 
-		OutVT.POV.Location += Offset;
+	if (CrouchBlendTime < CrouchBlendDuration)
+	{
+		CrouchBlendTime = FMath::Min(CrouchBlendTime + DeltaTime, CrouchBlendDuration);
+		BlendedOffset = FMath::Lerp(BlendFrom, BlendTarget, CrouchBlendTime / CrouchBlendDuration);
+	}
+	else
+	{
+		BlendedOffset = BlendTarget;
 	}
+
+	OutVT.POV.Location += BlendedOffset - CapsuleOffset;
 }
@@ -1,11 +1,16 @@
 #include "ZippyCharacter.h"
 
 #include "SurvivalCharacterMovementComponent.h"
+#include "ZippySpringArmComponent.h"
 #include "Camera/CameraComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "Components/InputComponent.h"
+#include "EnhancedInputComponent.h"
+#include "EnhancedInputSubsystems.h"
+#include "Engine/LocalPlayer.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "GameFramework/Controller.h"
+#include "GameFramework/PlayerController.h"
 #include "GameFramework/SpringArmComponent.h"
 
 AZippyCharacter::AZippyCharacter(const FObjectInitializer& ObjectInitializer)
@@ -30,7 +35,7 @@ AZippyCharacter::AZippyCharacter(const FObjectInitializer& ObjectInitializer)
 	GetCharacterMovement()->MinAnalogWalkSpeed = 20.f;
 	GetCharacterMovement()->BrakingDecelerationWalking = 2000.f;
 
-	CameraBoom = CreateDefaultSubobject<USpringArmComponent>(TEXT("CameraBoom"));
+	CameraBoom = CreateDefaultSubobject<UZippySpringArmComponent>(TEXT("CameraBoom"));
 	CameraBoom->SetupAttachment(RootComponent);
 	CameraBoom->TargetArmLength = 400.0f;
 	CameraBoom->bUsePawnControlRotation = true;
@@ -41,19 +46,89 @@ AZippyCharacter::AZippyCharacter(const FObjectInitializer& ObjectInitializer)
 }
 
 
+void AZippyCharacter::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	// Child actor components have spawned their actors by now
+	MarkIgnoreCharacterParamsDirty();
+}
+
+void AZippyCharacter::NotifyControllerChanged()
+{
+	Super::NotifyControllerChanged();
+
+	// AI only registrations are decided by who controls us
+	ZippyCharacterMovementComponent->RefreshControllerRegistration();
+
+	if (!DefaultMappingContext) return;
+	if (const APlayerController* PC = Cast<APlayerController>(Controller))
+	{
+		if (UEnhancedInputLocalPlayerSubsystem* InputSubsystem = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(PC->GetLocalPlayer()))
+		{
+			InputSubsystem->AddMappingContext(DefaultMappingContext, 0);
+		}
+	}
+}
+
 void AZippyCharacter::SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent)
 {
 	check(PlayerInputComponent);
-	PlayerInputComponent->BindAction("Jump", IE_Pressed, this, &AZippyCharacter::Jump);
-	PlayerInputComponent->BindAction("Jump", IE_Released, this, &AZippyCharacter::StopJumping);
+	UEnhancedInputComponent* EnhancedInput = Cast<UEnhancedInputComponent>(PlayerInputComponent);
+
+	if (EnhancedInput && JumpAction)
+	{
+		EnhancedInput->BindAction(JumpAction, ETriggerEvent::Started, this, &AZippyCharacter::BufferedPressed, (uint8)USurvivalCharacterMovementComponent::INPUT_Jump);
+		EnhancedInput->BindAction(JumpAction, ETriggerEvent::Completed, this, &AZippyCharacter::JumpReleased);
+	}
+	else
+	{
+		PlayerInputComponent->BindAction("Jump", IE_Pressed, this, &AZippyCharacter::Jump);
+		PlayerInputComponent->BindAction("Jump", IE_Released, this, &AZippyCharacter::StopJumping);
+	}
 
-	PlayerInputComponent->BindAxis("Move Forward / Backward", this, &AZippyCharacter::MoveForward);
-	PlayerInputComponent->BindAxis("Move Right / Left", this, &AZippyCharacter::MoveRight);
+	if (EnhancedInput && MoveAction)
+	{
+		EnhancedInput->BindAction(MoveAction, ETriggerEvent::Triggered, this, &AZippyCharacter::Move);
+	}
+	else
+	{
+		PlayerInputComponent->BindAxis("Move Forward / Backward", this, &AZippyCharacter::MoveForward);
+		PlayerInputComponent->BindAxis("Move Right / Left", this, &AZippyCharacter::MoveRight);
+	}
 
-	PlayerInputComponent->BindAxis("Turn Right / Left Mouse", this, &APawn::AddControllerYawInput);
-	PlayerInputComponent->BindAxis("Turn Right / Left Gamepad", this, &AZippyCharacter::TurnAtRate);
-	PlayerInputComponent->BindAxis("Look Up / Down Mouse", this, &APawn::AddControllerPitchInput);
-	PlayerInputComponent->BindAxis("Look Up / Down Gamepad", this, &AZippyCharacter::LookUpAtRate);
+	if (EnhancedInput && LookAction)
+	{
+		EnhancedInput->BindAction(LookAction, ETriggerEvent::Triggered, this, &AZippyCharacter::Look);
+	}
+	else
+	{
+		PlayerInputComponent->BindAxis("Turn Right / Left Mouse", this, &APawn::AddControllerYawInput);
+		PlayerInputComponent->BindAxis("Turn Right / Left Gamepad", this, &AZippyCharacter::TurnAtRate);
+		PlayerInputComponent->BindAxis("Look Up / Down Mouse", this, &APawn::AddControllerPitchInput);
+		PlayerInputComponent->BindAxis("Look Up / Down Gamepad", this, &AZippyCharacter::LookUpAtRate);
+	}
+
+	if (EnhancedInput)
+	{
+		if (CrouchAction)
+		{
+			EnhancedInput->BindAction(CrouchAction, ETriggerEvent::Started, this, &AZippyCharacter::CrouchPressed);
+			EnhancedInput->BindAction(CrouchAction, ETriggerEvent::Completed, this, &AZippyCharacter::CrouchReleased);
+		}
+
+		const TPair<UInputAction*, USurvivalCharacterMovementComponent::EBufferedInput> BufferedActions[] = {
+			{SlideAction, USurvivalCharacterMovementComponent::INPUT_Slide},
+			{DashAction, USurvivalCharacterMovementComponent::INPUT_Dash},
+			{ProneAction, USurvivalCharacterMovementComponent::INPUT_Prone},
+		};
+		for (const auto& [Action, Input] : BufferedActions)
+		{
+			if (!Action) continue;
+			EnhancedInput->BindAction(Action, ETriggerEvent::Started, this, &AZippyCharacter::BufferedPressed, (uint8)Input);
+			EnhancedInput->BindAction(Action, ETriggerEvent::Completed, this, &AZippyCharacter::BufferedReleased, (uint8)Input);
+		}
+	}
 
 	PlayerInputComponent->BindTouch(IE_Pressed, this, &AZippyCharacter::TouchStarted);
 	PlayerInputComponent->BindTouch(IE_Released, this, &AZippyCharacter::TouchStopped);
@@ -98,36 +173,76 @@ void AZippyCharacter::LookUpAtRate(float Rate)
 
 void AZippyCharacter::MoveForward(float Value)
 {
-	if ((Controller != nullptr) && (Value != 0.0f))
-	{
-		const FRotator Rotation = Controller->GetControlRotation();
-		const FRotator YawRotation(0, Rotation.Yaw, 0);
-		const FVector Direction = FRotationMatrix(YawRotation).GetUnitAxis(EAxis::X);
-		AddMovementInput(Direction, Value);
-	}
+	if (Value != 0.0f) AddMoveInput(FVector2D(0.f, Value));
 }
 
 void AZippyCharacter::MoveRight(float Value)
 {
-	if ( (Controller != nullptr) && (Value != 0.0f) )
-	{
-		const FRotator Rotation = Controller->GetControlRotation();
-		const FRotator YawRotation(0, Rotation.Yaw, 0);
-		const FVector Direction = FRotationMatrix(YawRotation).GetUnitAxis(EAxis::Y);
-		AddMovementInput(Direction, Value);
-	}
+	if (Value != 0.0f) AddMoveInput(FVector2D(Value, 0.f));
 }
 
+void AZippyCharacter::Move(const FInputActionValue& Value)
+{
+	AddMoveInput(Value.Get<FVector2D>());
+}
 
+void AZippyCharacter::Look(const FInputActionValue& Value)
+{
+	const FVector2D LookInput = Value.Get<FVector2D>();
+	AddControllerYawInput(LookInput.X);
+	AddControllerPitchInput(LookInput.Y);
+}
 
-FCollisionQueryParams AZippyCharacter::GetIgnoreCharacterParams() const
+void AZippyCharacter::AddMoveInput(const FVector2D& Input)
 {
-	FCollisionQueryParams Params;
+	if (Controller == nullptr || Input.IsZero()) return;
+
+	const FRotator YawRotation(0, Controller->GetControlRotation().Yaw, 0);
+	AddMovementInput(YawRotation.RotateVector(FVector(Input.Y, Input.X, 0.f)));
+}
 
-	TArray<AActor*> CharacterChildren;
-	GetAllChildActors(CharacterChildren);
-	Params.AddIgnoredActors(CharacterChildren);
-	Params.AddIgnoredActor(this);
+void AZippyCharacter::JumpReleased()
+{
+	BufferedReleased(USurvivalCharacterMovementComponent::INPUT_Jump);
+	// Leaves bPressedZippyJump to the movement, a tap released before the next move still jumps
+	ACharacter::StopJumping();
+}
+
+void AZippyCharacter::CrouchPressed()
+{
+	ZippyCharacterMovementComponent->StartCrouch();
+}
+
+void AZippyCharacter::CrouchReleased()
+{
+	ZippyCharacterMovementComponent->StopCrouch();
+}
+
+void AZippyCharacter::BufferedPressed(uint8 Input)
+{
+	ZippyCharacterMovementComponent->BufferPress(static_cast<USurvivalCharacterMovementComponent::EBufferedInput>(Input));
+}
+
+void AZippyCharacter::BufferedReleased(uint8 Input)
+{
+	ZippyCharacterMovementComponent->BufferRelease(static_cast<USurvivalCharacterMovementComponent::EBufferedInput>(Input));
+}
+
+
+
+const FCollisionQueryParams& AZippyCharacter::GetIgnoreCharacterParams() const
+{
+	if (bIgnoreCharacterParamsDirty)
+	{
+		IgnoreCharacterParams = FCollisionQueryParams();
+
+		TArray<AActor*> CharacterChildren;
+		GetAllChildActors(CharacterChildren);
+		IgnoreCharacterParams.AddIgnoredActors(CharacterChildren);
+		IgnoreCharacterParams.AddIgnoredActor(this);
+
+		bIgnoreCharacterParamsDirty = false;
+	}
 
-	return Params;
+	return IgnoreCharacterParams;
 }
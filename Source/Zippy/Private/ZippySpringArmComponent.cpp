@@ -0,0 +1,28 @@
+#include "ZippySpringArmComponent.h"
+
+void UZippySpringArmComponent::UpdateDesiredArmLocation(bool bDoTrace, bool bDoLocationLag, bool bDoRotationLag, float DeltaTime)
+{
+	TimeSinceProbe += DeltaTime;
+
+	// Lag keeps moving the camera after its inputs stop changing, so only throttle without it
+	// The socket transform is relative to the component, so a component turning in place moves the camera too
+	const FVector ArmLocation = GetComponentLocation() + TargetOffset;
+	const FQuat ComponentRotation = GetComponentQuat();
+	const FRotator TargetRotation = GetTargetRotation();
+	const bool bStationary = !bDoLocationLag && !bDoRotationLag
+		&& ArmLocation.Equals(LastArmLocation)
+		&& ComponentRotation.Equals(LastComponentRotation)
+		&& TargetRotation.Equals(LastTargetRotation)
+		&& TargetArmLength == LastArmLength;
+
+	// The socket transform from the last update still holds
+	if (bStationary && TimeSinceProbe < StationaryProbeInterval) return;
+
+	LastArmLocation = ArmLocation;
+	LastComponentRotation = ComponentRotation;
+	LastTargetRotation = TargetRotation;
+	LastArmLength = TargetArmLength;
+	if (bDoTrace) TimeSinceProbe = 0.f;
+
+	Super::UpdateDesiredArmLocation(bDoTrace, bDoLocationLag, bDoRotationLag, DeltaTime);
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Zippy.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "ClimbPointSubsystem.generated.h"
+
+/**
+ * World subsystem that keeps every climb point (any actor tagged "Climb Point", e.g. the ClimbPoint blueprint)
+ * in a uniform grid, so hang checks only look at a few nearby cells instead of overlapping the whole static world.
+ * Climb points are registered when play begins, when they spawn and when their level streams in.
+ * They are treated as static and indexed by their location at registration.
+ */
+UCLASS()
+class ZIPPY_API UClimbPointSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** The actor tag that marks an actor as a climb point. */
+	static const FName ClimbPointTag;
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+public:
+	/**
+	 * Adds a climb point to the index. Called automatically for tagged actors.
+	 * @param ClimbPoint The actor to register.
+	 */
+	UFUNCTION(BlueprintCallable)
+	void RegisterClimbPoint(AActor* ClimbPoint);
+
+	/**
+	 * Removes a climb point from the index. Called automatically when a registered actor is destroyed.
+	 * @param ClimbPoint The actor to unregister.
+	 */
+	UFUNCTION(BlueprintCallable)
+	void UnregisterClimbPoint(AActor* ClimbPoint);
+
+	/**
+	 * Finds the highest climb point that lies inside an oriented box.
+	 * @param Center The center of the box.
+	 * @param Rotation The rotation of the box.
+	 * @param Extent The half size of the box.
+	 * @return The highest climb point in the box, or nullptr if there is none.
+	 */
+	AActor* FindHighestClimbPoint(const FVector& Center, const FQuat& Rotation, const FVector& Extent) const;
+
+private:
+	/** Size of one grid cell, a little larger than the hang check box so a query touches few cells. */
+	static constexpr float CellSize = 400.f;
+
+	struct FClimbPoint
+	{
+		TWeakObjectPtr<AActor> Actor;
+		FVector Location;
+		/** Bounding radius of the climb point, so points whose collision only touches the box still count. */
+		float Radius;
+	};
+
+	FIntVector GetCell(const FVector& Location) const;
+
+	void OnActorSpawned(AActor* Actor);
+	void OnLevelAdded(ULevel* Level, UWorld* InWorld);
+	void OnLevelRemoved(ULevel* Level, UWorld* InWorld);
+
+	UFUNCTION()
+	void OnClimbPointDestroyed(AActor* DestroyedActor);
+
+	/** Climb points bucketed by grid cell. */
+	TMap<FIntVector, TArray<FClimbPoint>> Cells;
+
+	/** The cell each registered climb point lives in, used to unregister it. */
+	TMap<TObjectKey<AActor>, FIntVector> ClimbPointCells;
+
+	/** Largest Radius of any registered climb point, queries are padded by it. */
+	float MaxClimbPointRadius = 0.f;
+
+	FDelegateHandle ActorSpawnedHandle;
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+};
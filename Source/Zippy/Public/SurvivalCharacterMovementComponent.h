@@ -3,6 +3,10 @@
 #include "CoreMinimal.h"
 #include "Zippy.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "WorldCollision.h"
+#include "SurvivalMovementCapture.h"
+#include "SurvivalMovementCurve.h"
+#include "SurvivalMovementDebug.h"
 #include "SurvivalCharacterMovementComponent.generated.h"
 
 /**
@@ -54,6 +58,29 @@ enum ECustomMovementMode
 	CMOVE_MAX UMETA(Hidden),
 };
 
+/**
+ * Root motion transitions into and between movement states, and the follow-up actions that can be queued after them.
+ * Packed into 3 bits in the saved move.
+ */
+UENUM(BlueprintType)
+enum class ESurvivalTransition : uint8
+{
+	/** No transition in progress or queued. */
+	None,
+
+	/** Mantling onto a ledge at step height, followed by the short mantle montage. */
+	ShortMantle,
+
+	/** Mantling onto a ledge taller than the capsule, followed by the tall mantle montage. */
+	TallMantle,
+
+	/** Moving onto a climb point, ends in the hang movement mode. */
+	Hang,
+
+	/** Attaching to the wall in front, only used as a queued follow-up. */
+	Climb,
+};
+
 DECLARE_LOG_CATEGORY_EXTERN(LogSurvivalCharacterMovement, Log, All);
 
 /**
@@ -113,6 +140,16 @@ class ZIPPY_API USurvivalCharacterMovementComponent : public UCharacterMovementC
 		 */
 		virtual bool CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* InCharacter, float MaxDelta) const override;
 
+		/**
+		 * Combines this move with the pending move it follows. Rewinds the move time counters and the fixed step remainder
+		 * to where the pending move started, as the engine does for the jump counters, so the combined move does not count the pending move's time twice.
+		 * @param OldMove The pending move being combined into this one.
+		 * @param InCharacter The character using this movement component.
+		 * @param PC The controller of the character.
+		 * @param OldStartLocation Where the pending move started.
+		 */
+		virtual void CombineWith(const FSavedMove_Character* OldMove, ACharacter* InCharacter, APlayerController* PC, const FVector& OldStartLocation) override;
+
 		/**
 		 * Resets this saved move's data, clearing out all recorded state.
 		 */
@@ -139,6 +176,16 @@ class ZIPPY_API USurvivalCharacterMovementComponent : public UCharacterMovementC
 		 * @param C The character that will use this move.
 		 */
 		virtual void PrepMoveFor(ACharacter* C) override;
+
+		/**
+		 * Called after this move is performed or replayed. Records which environment probes failed during it.
+		 * @param C The character that used this move.
+		 * @param PostUpdateMode Whether the move was just recorded or replayed.
+		 */
+		virtual void PostUpdate(ACharacter* C, EPostUpdateMode PostUpdateMode) override;
+
+		/** @return The FSurvivalNetworkMoveData::ESurvivalFlags this move is sent with. */
+		uint8 GetSurvivalFlags() const;
 		
 		/** Whether the Zippy jump input was pressed (custom jump). */
 		uint8 Saved_bPressedZippyJump : 1;
@@ -158,14 +205,47 @@ class ZIPPY_API USurvivalCharacterMovementComponent : public UCharacterMovementC
 		/** Whether a special transition (e.g., mantle) has finished on this tick. */
 		uint8 Saved_bTransitionFinished : 1;
 
+		/** The transition in progress, an ESurvivalTransition. */
+		uint8 Saved_Transition : 3;
+
+		/** The transition queued to follow the one in progress, an ESurvivalTransition. */
+		uint8 Saved_QueuedTransition : 3;
+
+		/** Root motion source ID of the transition in progress. */
+		uint16 Saved_TransitionRMS_ID;
+
+		/** Unsimulated time carried into this move by the fixed step accumulator. */
+		float Saved_FixedStepRemainder;
+
+		/** The EProbeDecision probes that failed during this move, reused instead of probing again when the move is replayed. */
+		uint8 Saved_ProbeFailures : 4;
+
 		/** Previous crouch state, used to detect transitions. */
 		uint8 Saved_bPrevWantsToCrouch : 1;
 
-		/** Whether the player wants to prone. */
+		/** Whether the player is holding crouch, held long enough it enters prone. */
+		uint8 Saved_bCrouchHeld : 1;
+
+		/** Whether the player pressed prone, entering it right away. */
 		uint8 Saved_bWantsToProne : 1;
 
+		/** Move time crouch has been held for. */
+		float Saved_CrouchHoldTime;
+
+		/** Move time left before the character can dash again. */
+		float Saved_DashCooldownLeft;
+
 		/** Tracks wall-running direction (true if right side, false if left). */
 		uint8 Saved_bWallRunIsRight : 1;
+
+		/** Whether the character dashed during this move, recorded after it. */
+		uint8 Saved_bDashed : 1;
+
+	private:
+
+		/** The stock combine thresholds, restored when the move is not in a steady custom mode. */
+		float DefaultAccelDotThresholdCombine;
+		float DefaultAccelMagThreshold;
 		
 	};
 
@@ -194,6 +274,140 @@ class ZIPPY_API USurvivalCharacterMovementComponent : public UCharacterMovementC
 		
 	};
 
+	/**
+	 * Network move data that carries the survival state the compressed flags have no room for, as packed bits.
+	 * Acceleration and location are quantized by how much precision the movement mode needs,
+	 * and pending/old moves are delta encoded against the new move, which is always serialized first.
+	 */
+	struct FSurvivalNetworkMoveData : public FCharacterNetworkMoveData
+	{
+		/** Survival state bits, captured before the move like the rest of the saved move. */
+		enum ESurvivalFlags : uint8
+		{
+			SFLAG_CrouchHeld		= 0x01,
+			SFLAG_WallRunIsRight	= 0x02,
+			SFLAG_TransitionFinished	= 0x04,
+			SFLAG_PrevWantsToCrouch	= 0x08,
+			SFLAG_WantsToProne		= 0x10,
+			/** Captured after the move, the client dashed during it. */
+			SFLAG_Dashed			= 0x20,
+		};
+
+		/** Number of bits SurvivalFlags is serialized with. */
+		static constexpr int32 SurvivalFlagBits = 6;
+
+		/** Precision the acceleration is sent with. */
+		enum EAccelPrecision : uint8
+		{
+			/** No acceleration, nothing else is sent. */
+			AccelPrecision_Zero,
+			/** Whole cm/s^2, used by the custom movement modes. */
+			AccelPrecision_Whole,
+			/** One decimal place, same as the stock FVector_NetQuantize10. */
+			AccelPrecision_Tenth,
+		};
+
+		/** The move data pending and old moves are delta encoded against. */
+		const FSurvivalNetworkMoveData* DeltaBase = nullptr;
+
+		/** Packed ESurvivalFlags. */
+		uint8 SurvivalFlags = 0;
+
+		/** Whether the move ended in a custom mode, where location is only needed to one decimal place for error checking. */
+		bool bCoarseLocation = false;
+
+		/**
+		 * Fills the move data from a client saved move, including the survival flags.
+		 * @param ClientMove The saved move to send.
+		 * @param MoveType Whether this is the new, pending or old move.
+		 */
+		virtual void ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove, ENetworkMoveType MoveType) override;
+
+		/**
+		 * Reads or writes the move data.
+		 * @param CharacterMovement The movement component the move belongs to.
+		 * @param Ar The archive to serialize with.
+		 * @param PackageMap The package map used for object references.
+		 * @param MoveType Whether this is the new, pending or old move.
+		 * @return True if serialization succeeded.
+		 */
+		virtual bool Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap, ENetworkMoveType MoveType) override;
+	};
+
+	/**
+	 * Move data container holding FSurvivalNetworkMoveData, with the pending and old move delta encoded against the new move.
+	 */
+	struct FSurvivalNetworkMoveDataContainer : public FCharacterNetworkMoveDataContainer
+	{
+		/** Sets up the new, pending and old move data references. */
+		FSurvivalNetworkMoveDataContainer();
+
+		/** Storage for the new, pending and old move, in that order. */
+		FSurvivalNetworkMoveData MoveData[3];
+	};
+
+	/** Number of stacked front traces TryMantle uses to find a wall face. */
+	static constexpr int32 MantleFrontProbeCount = 6;
+
+	/**
+	 * Environment traces shared by TryMantle, TryWallRun, TryHang and TryClimb.
+	 * Each probe is traced at most once per batch, the batch is only re-gathered once the capsule
+	 * moves, rotates or resizes past ProbeReuseTolerance or the batch is older than the previous frame.
+	 * Network predicted characters start a new batch every move, and hits on movable geometry are never kept.
+	 */
+	struct FMovementProbeBatch
+	{
+		enum EProbe : uint8
+		{
+			/** First of MantleFrontProbeCount front face traces, stacked bottom to top. */
+			Probe_MantleFront,
+			/** Down trace checking that we are high enough to wall run. */
+			Probe_WallRunFloor = Probe_MantleFront + MantleFrontProbeCount,
+			/** Side traces looking for a wall to run along. */
+			Probe_WallRunLeft,
+			Probe_WallRunRight,
+			/** Forward trace shared by hang and climb, traced to the longer of the two reaches. */
+			Probe_Forward,
+			Probe_Num
+		};
+
+		/** Capsule state the probes were traced from. */
+		FVector Origin = FVector::ZeroVector;
+		FQuat Rotation = FQuat::Identity;
+		float CapsuleHalfHeight = 0.f;
+		uint64 Frame = 0;
+
+		/** Bit per EProbe, set once that probe has been traced into Hits. */
+		uint32 ResolvedMask = 0;
+		FHitResult Hits[Probe_Num];
+	};
+
+	/**
+	 * A surface PhysWallRun or PhysClimb is moving along (or the lack of one, for floor checks).
+	 * Only reused as is while the capsule has not moved since it was traced, a wall that was hit is otherwise re-checked
+	 * with a short trace. Dropped when the mode changes, a correction is received or a move hits a different component.
+	 * Network predicted characters also drop them at the start of every move, so a move simulates the same on the server,
+	 * the client and in replays.
+	 */
+	struct FSurfaceContact
+	{
+		/** Whether the record holds a trace result. */
+		bool bValid = false;
+
+		/** Whether the trace hit anything. */
+		bool bHit = false;
+
+		/** Capsule location, direction and length the trace was made with. */
+		FVector Origin = FVector::ZeroVector;
+		FVector Direction = FVector::ZeroVector;
+		float TraceLength = 0.f;
+
+		/** The surface that was hit. */
+		FVector Normal = FVector::ZeroVector;
+		float Distance = 0.f;
+		TWeakObjectPtr<UPrimitiveComponent> Component;
+	};
+
 
 protected:
 
@@ -205,6 +419,17 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Character Movement: Walking", meta=(ClampMin="0", UIMin="0", ForceUnits="cm/s"))
 	float MaxSprintSpeed = 750.f;
 
+	#pragma endregion
+
+	#pragma region Ground Modes
+
+	/**
+	 * Whether slide and prone carry the floor over from the last move instead of sweeping for it, when the move slid cleanly
+	 * along a face of a static floor. A line trace confirms the face is still under the capsule.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Character Movement: Ground Modes")
+	bool bReuseAdjacentFloor = false;
+
 	#pragma endregion
 	
 	#pragma region Slide
@@ -269,10 +494,6 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Character Movement: Dash", meta=(ClampMin="0", UIMin="0", Units="s"))
 	float DashCooldownDuration = 1.f;
 
-	/** The cooldown duration for the server to accept a new dash (slightly shorter than client). */
-	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Character Movement: Dash", meta=(ClampMin="0", UIMin="0", Units="s"))
-	float AuthDashCooldownDuration = 0.9f;
-
 	/** Montage played when starting a dash. */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Character Movement: Dash|Montages")
 	UAnimMontage* DashMontage;
@@ -305,6 +526,22 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Character Movement: Mantle", meta=(ClampMin="0", UIMin="0", Units="degrees"))
 	float MantleMaxAlignmentAngle = 45;
 
+	/** Characters falling faster than this do not try to mantle, before any trace is made. Zero allows any fall speed. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Character Movement: Mantle", meta=(ClampMin="0", UIMin="0", ForceUnits="cm/s"))
+	float MantleMaxFallSpeed = 0;
+
+	/**
+	 * A mantle search that found nothing is reused while the character stays within this distance of where it ran
+	 * and faces the same way, so holding jump along a wall does not search again every tick. Zero disables the cache.
+	 * Only used by characters no remote client predicts (standalone, a listen server's own character, AI).
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Character Movement: Mantle", meta=(ClampMin="0", UIMin="0", ForceUnits="cm"))
+	float MantleCacheTolerance = 5;
+
+	/** How long a failed mantle search is reused, so geometry moving into reach is picked up again. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Character Movement: Mantle", meta=(ClampMin="0", UIMin="0", ForceUnits="s"))
+	float MantleCacheLifetime = .2f;
+
 	/** Animation montage for a tall mantle (climbing a high ledge). */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Character Movement: Mantle|Montages")
 	UAnimMontage* TallMantleMontage;
@@ -361,7 +598,10 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Character Movement: Wall Run", meta=(ClampMin="0", UIMin="0", ForceUnits="cm/s"))
 	float WallJumpOffForce = 300.f;
 	
-	/** A curve controlling gravity scaling during wall run, typically set up so it’s lower at certain input angles. */
+	/**
+	 * A curve controlling gravity scaling during wall run, typically set up so it’s lower at certain input angles.
+	 * Baked by RefreshTuningCurves, without a curve wall runs use full gravity.
+	 */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Character Movement: Wall Run")
 	UCurveFloat* WallRunGravityScaleCurve;
 
@@ -393,6 +633,143 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Character Movement: Climb", meta=(ClampMin="0", UIMin="0", ForceUnits="cm/s"))
 	float ClimbReachDistance = 200.f;
 
+	/** How far in front of the capsule to check for a wall to hang from. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Character Movement: Climb", meta=(ClampMin="0", UIMin="0", ForceUnits="cm"))
+	float HangReachDistance = 300.f;
+
+	#pragma endregion
+
+	#pragma region Probes
+
+	/** How far the capsule may drift before the environment probes gathered on the last tick are traced again. Network predicted characters never keep probes across moves. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Character Movement: Probes", meta=(ClampMin="0", UIMin="0", ForceUnits="cm"))
+	float ProbeReuseTolerance = 0.5f;
+
+	/**
+	 * How far a replayed move may start from where it was first simulated and still reuse its recorded probe failures.
+	 * Further than this and mantle, hang, climb and wall run probe the world again.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Character Movement: Probes", meta=(ClampMin="0", UIMin="0", ForceUnits="cm"))
+	float ProbeReplayTolerance = 2.f;
+
+	/**
+	 * Whether this character, when controlled by AI on the server, has the probes of its next tick traced ahead of time
+	 * on the async trace worker threads by USurvivalMovementBatchSubsystem.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Character Movement: Probes")
+	bool bBatchServerProbes = false;
+
+	#pragma endregion
+
+	#pragma region Networking
+
+	/** Whether saved moves made while sliding, proning, wall running, hanging or climbing use the looser steady mode combine thresholds below. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Character Movement: Networking")
+	bool bCombineSteadyCustomMoves = true;
+
+	/** Minimum dot product between the acceleration directions of two moves in a steady custom mode for them to combine. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Character Movement: Networking", meta=(ClampMin="-1", ClampMax="1", UIMin="-1", UIMax="1", EditCondition="bCombineSteadyCustomMoves"))
+	float SteadyMoveAccelDotThresholdCombine = 0.95f;
+
+	/** Maximum difference in acceleration magnitude between two moves in a steady custom mode for them to combine. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Character Movement: Networking", meta=(ClampMin="0", UIMin="0", ForceUnits="cm/s^2", EditCondition="bCombineSteadyCustomMoves"))
+	float SteadyMoveAccelMagThreshold = 100.f;
+
+	/** Position error the server tolerates while sliding before a move counts against the error budget. Zero uses the game network manager's tolerance. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Character Movement: Networking", meta=(ClampMin="0", UIMin="0", ForceUnits="cm"))
+	float ServerSlidePositionTolerance = 8.f;
+
+	/** Position error the server tolerates while proning before a move counts against the error budget. Zero uses the game network manager's tolerance. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Character Movement: Networking", meta=(ClampMin="0", UIMin="0", ForceUnits="cm"))
+	float ServerPronePositionTolerance = 0.f;
+
+	/** Position error the server tolerates while wall running before a move counts against the error budget. Zero uses the game network manager's tolerance. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Character Movement: Networking", meta=(ClampMin="0", UIMin="0", ForceUnits="cm"))
+	float ServerWallRunPositionTolerance = 12.f;
+
+	/** Position error the server tolerates while hanging or climbing before a move counts against the error budget. Zero uses the game network manager's tolerance. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Character Movement: Networking", meta=(ClampMin="0", UIMin="0", ForceUnits="cm"))
+	float ServerClimbPositionTolerance = 6.f;
+
+	/** Position error above which the server always corrects, whatever is left in the error budget. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Character Movement: Networking", meta=(ClampMin="0", UIMin="0", ForceUnits="cm"))
+	float ServerMaxPositionTolerance = 40.f;
+
+	/**
+	 * Error, in centimetre seconds above the tolerance, a client may build up before the server sends a correction.
+	 * Zero corrects every move outside the tolerance, like the default movement component.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Character Movement: Networking", meta=(ClampMin="0", UIMin="0"))
+	float ServerPositionErrorBudget = 2.f;
+
+	/** How fast the error budget refills per second of moves within tolerance. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Character Movement: Networking", meta=(ClampMin="0", UIMin="0"))
+	float ServerPositionErrorBudgetRecoveryRate = 1.f;
+
+	/** How often the server logs a summary of its move validation for this character. Zero disables the summary. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Character Movement: Networking", meta=(ClampMin="0", UIMin="0", ForceUnits="s"))
+	float ServerValidationReportInterval = 30.f;
+
+	/**
+	 * Whether sliding, proning, wall running and climbing simulate in fixed steps of FixedStepTime, carrying the leftover time to the next move.
+	 * Keeps client and server results the same at any frame rate, the mesh is interpolated between steps on the locally controlled character.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Character Movement: Networking")
+	bool bUseFixedStepCustomModes = false;
+
+	/** Length of one fixed step. Keep it at or below MaxSimulationTimeStep so each step is simulated in one go. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Character Movement: Networking", meta=(ClampMin="0.005", ClampMax="0.05", UIMin="0.005", UIMax="0.05", ForceUnits="s", EditCondition="bUseFixedStepCustomModes"))
+	float FixedStepTime = 1.f / 60.f;
+
+	#pragma endregion
+
+	#pragma region Proxy
+
+	/**
+	 * Simulated proxies further than this from the local view run the low detail path: no extrapolation, no traces and no montages.
+	 * Zero keeps every proxy at full detail.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Character Movement: Proxy", meta=(ClampMin="0", UIMin="0", ForceUnits="cm"))
+	float ProxyLowDetailDistance = 3000.f;
+
+	#pragma endregion
+
+	#pragma region Input
+
+	/**
+	 * How long a press through BufferPress stays pending for the movement to act on it.
+	 * A jump pressed just before landing or a dash pressed just before its cooldown ends still goes through.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Character Movement: Input", meta=(ClampMin="0", UIMin="0", ForceUnits="s"))
+	float InputBufferDuration = .15f;
+
+	#pragma endregion
+
+	#pragma region Significance
+
+	/**
+	 * Whether server side AI characters and simulated proxies lower their tick rate when no player is near, through the significance manager.
+	 * Locally controlled characters and the server copies of player characters always tick at full rate.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Character Movement: Significance")
+	bool bUseMovementSignificance = false;
+
+	/** Characters within this distance of any player view tick every frame at full quality. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Character Movement: Significance", meta=(ClampMin="0", UIMin="0", ForceUnits="cm", EditCondition="bUseMovementSignificance"))
+	float SignificanceFullDistance = 2500.f;
+
+	/** Characters within this distance of any player view tick at ReducedTickInterval, further than this at MinimalTickInterval. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Character Movement: Significance", meta=(ClampMin="0", UIMin="0", ForceUnits="cm", EditCondition="bUseMovementSignificance"))
+	float SignificanceReducedDistance = 6000.f;
+
+	/** Tick interval of characters between SignificanceFullDistance and SignificanceReducedDistance from the nearest player. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Character Movement: Significance", meta=(ClampMin="0", UIMin="0", ForceUnits="s", EditCondition="bUseMovementSignificance"))
+	float ReducedTickInterval = 1.f / 30.f;
+
+	/** Tick interval of characters further than SignificanceReducedDistance from every player. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Character Movement: Significance", meta=(ClampMin="0", UIMin="0", ForceUnits="s", EditCondition="bUseMovementSignificance"))
+	float MinimalTickInterval = .1f;
+
 	#pragma endregion
 
 #pragma endregion
@@ -407,9 +784,15 @@ protected:
 	/** Whether the character wants to slide. Mirrors Saved_bWantsToSlide. */
 	bool Safe_bWantsToSlide;
 
-	/** Whether the character wants to prone. Mirrors Saved_bWantsToProne. */
+	/** Whether the player is holding crouch. Mirrors Saved_bCrouchHeld. */
+	bool Safe_bCrouchHeld;
+
+	/** Whether the player pressed prone. Mirrors Saved_bWantsToProne. */
 	bool Safe_bWantsToProne;
 
+	/** Move time crouch has been held for, prone is entered once it passes ProneEnterHoldDuration. Mirrors Saved_CrouchHoldTime. */
+	float Safe_CrouchHoldTime = 0.f;
+
 	/** Whether the character wants to dash. Mirrors Saved_bWantsToDash. */
 	bool Safe_bWantsToDash;
 
@@ -419,37 +802,181 @@ protected:
 	/** Caches the previous frame's crouch state, used for transition logic. */
 	bool Safe_bPrevWantsToCrouch;
 
-	/** Time at which dash was started, used for cooldown checks. */
-	float DashStartTime;
+	/** Move time left before the character can dash again, counted down by every move. Mirrors Saved_DashCooldownLeft. */
+	float Safe_DashCooldownLeft = 0.f;
+
+	/** A press from BufferPress, pending until InputBufferDuration after PressTime or until the movement consumes it. */
+	struct FBufferedPress
+	{
+		double PressTime = 0.;
+		bool bPending = false;
+		bool bHeld = false;
+	};
+
+	/** The last TryMantle search that found nothing to mantle onto, and what it was searched from. */
+	struct FMantleCache
+	{
+		double Time = -1.;
+		FVector Location = FVector::ZeroVector;
+		FVector Forward = FVector::ZeroVector;
+		float CheckDistance = 0.f;
+		uint8 MovementMode = MOVE_None;
+
+		/** The wall the search hit, if any. The result no longer holds once it moves. */
+		bool bHadWall = false;
+		TWeakObjectPtr<UPrimitiveComponent> WallComponent;
+		FVector WallLocation = FVector::ZeroVector;
+	};
+
+	FMantleCache MantleCache;
+
+	/** Room reserved up front in HitScratch, more than a mantle height trace usually returns. */
+	static constexpr int32 HitScratchCapacity = 8;
+
+	/**
+	 * Reused result buffer for multi hit queries, so speculative checks do not allocate.
+	 * Reset before every query, only valid until the next one.
+	 */
+	TArray<FHitResult> HitScratch;
+
+	/** Writer of the zippy.Movement.Capture capture, set on a sampled autonomous proxy from BeginPlay to EndPlay. */
+	TUniquePtr<FSurvivalMovementCaptureWriter> CaptureWriter;
+
+	/** Whether the move being recorded was combined with the pending move, so its capture replaces the pending move's. */
+	bool bCaptureCombinedMove = false;
 
-	/** Timer handle for entering prone after holding crouch for a certain duration. */
-	FTimerHandle TimerHandle_EnterProne;
+	/** Buffered presses, indexed by EBufferedInput. */
+	FBufferedPress BufferedPresses[INPUT_MAX];
 
-	/** Timer handle for dash cooldown logic. */
-	FTimerHandle TimerHandle_DashCooldown;
+	/** Whether the client dashed during the move the server is running, so a dash the server turns down is counted. */
+	bool bClientDashed = false;
+
+	/** Whether PerformDash ran during the current move. */
+	bool bDashedThisMove = false;
 
 	/** Whether a transition (mantle, etc.) has finished this frame. Mirrors Saved_bTransitionFinished. */
 	bool Safe_bTransitionFinished;
 
-	/** A shared pointer to the Root Motion Source used for transitions (like mantling). */
-	TSharedPtr<FRootMotionSource_MoveToForce> TransitionRMS;
+	/** The pooled Root Motion Source used by the latest transition (like mantling). */
+	FRootMotionSource_MoveToForce* TransitionRMS = nullptr;
 
-	/** Name identifying the type of transition (e.g., "Mantle", "Hang") currently in progress. */
-	FString TransitionName;
+	/**
+	 * Root Motion Sources reused between transitions. An entry is free once the movement component has let go of it,
+	 * so only overlapping transitions grow the pool.
+	 */
+	TArray<TSharedPtr<FRootMotionSource_MoveToForce>, TInlineAllocator<2>> TransitionRMSPool;
 
-	/** Montage that is queued to play immediately after a root-motion transition completes. */
-	UPROPERTY(Transient)
-	UAnimMontage* TransitionQueuedMontage;
+	/** The transition currently in progress. Mirrors Saved_Transition. */
+	ESurvivalTransition Safe_Transition = ESurvivalTransition::None;
+
+	/** The transition to start once the current one finishes, so transitions can be chained (mantle -> hang -> climb). Mirrors Saved_QueuedTransition. */
+	ESurvivalTransition Safe_QueuedTransition = ESurvivalTransition::None;
 
-	/** Play speed for the queued transition montage, based on velocity or other logic. */
+	/** Play speed for the montage that follows a mantle transition, based on velocity or other logic. */
 	float TransitionQueuedMontageSpeed;
 
-	/** Root-motion source ID returned by ApplyRootMotionSource, for removing later. */
-	int TransitionRMS_ID;
+	/** Root-motion source ID returned by ApplyRootMotionSource, for removing later. Mirrors Saved_TransitionRMS_ID. */
+	uint16 TransitionRMS_ID = 0;
+
+	/** Probes run by UpdateCharacterStateBeforeMovement whose failures are recorded in the saved move. */
+	enum EProbeDecision : uint8
+	{
+		PROBE_Mantle	= 0x01,
+		PROBE_Hang		= 0x02,
+		PROBE_Climb		= 0x04,
+		PROBE_WallRun	= 0x08,
+	};
+
+	/** EProbeDecision probes that failed during the current move. Mirrors Saved_ProbeFailures. */
+	uint8 ProbeFailures = 0;
+
+	/** EProbeDecision probes that failed when the move being replayed was first simulated. */
+	uint8 ReplayProbeFailures = 0;
+
+	/** Set by PrepMoveFor when the move being replayed starts close enough to its original location to reuse ReplayProbeFailures. */
+	bool bReplayProbeDecisions = false;
+
+	/** Time accumulated in a fixed step mode that has not been simulated yet. Mirrors Saved_FixedStepRemainder. */
+	float FixedStepRemainder = 0.f;
+
+	/** Capsule location before the last fixed step, the mesh is interpolated from here towards the current location. */
+	FVector FixedStepPrevLocation = FVector::ZeroVector;
+
+	/** Whether the mesh is currently offset from its base translation by fixed step interpolation. */
+	bool bFixedStepMeshOffset = false;
 
 	/** Used in wall-running to indicate which side of the wall the character is on. */
 	bool Safe_bWallRunIsRight;
 
+	/** Environment probes gathered for the current movement tick. */
+	FMovementProbeBatch ProbeBatch;
+
+	/**
+	 * Values derived from the tuning properties that the movement code would otherwise recompute every call.
+	 * Rebuilt by RefreshDerivedConstants.
+	 */
+	struct FDerivedConstants
+	{
+		float CosMantleMinWallSteepnessAngle = 0.f;
+		float CosMantleMaxSurfaceAngle = 0.f;
+		float CosMantleMaxAlignmentAngle = 0.f;
+
+		float SinWallRunPullAwayAngle = 0.f;
+
+		float MinSlideSpeedSquared = 0.f;
+		float MinWallRunSpeedSquared = 0.f;
+	};
+
+	/** The derived constants for the current tuning. */
+	FDerivedConstants Derived;
+
+	/** WallRunGravityScaleCurve as of the last RefreshTuningCurves. */
+	FSurvivalBakedCurve WallRunGravityScale;
+
+	/**
+	 * Settings and hooks for one custom movement mode. Tuning values point at the component property to read, null reads as zero.
+	 * Adding a mode means adding its row to ModeDescriptors instead of a case to every switch.
+	 */
+	struct FModeDescriptor
+	{
+		using FTuning = float USurvivalCharacterMovementComponent::*;
+		using FPhysFunc = void (USurvivalCharacterMovementComponent::*)(float, int32);
+		using FEnterFunc = void (USurvivalCharacterMovementComponent::*)(EMovementMode, ECustomMovementMode);
+		using FExitFunc = void (USurvivalCharacterMovementComponent::*)();
+
+		FTuning MaxSpeed;
+		FTuning BrakingDeceleration;
+		FPhysFunc Phys;
+		FEnterFunc Enter;
+		FExitFunc Exit;
+
+		/** Whether the mode simulates in fixed steps when bUseFixedStepCustomModes is set. */
+		bool bFixedStep;
+	};
+
+	/** Descriptor of every custom movement mode, indexed by ECustomMovementMode. */
+	static const FModeDescriptor ModeDescriptors[CMOVE_MAX];
+
+	/**
+	 * @param CustomMode The custom movement mode to look up.
+	 * @return The descriptor for CustomMode, or the CMOVE_None descriptor if it is out of range.
+	 */
+	static const FModeDescriptor& GetModeDescriptor(uint8 CustomMode);
+
+	/** The wall being run along or climbed, and the floor check below it. */
+	FSurfaceContact WallContact;
+	FSurfaceContact FloorContact;
+
+	/** Delegate for the async traces queued by PrefetchProbes. */
+	FTraceDelegate PrefetchTraceDelegate;
+
+	/** UserData values of the prefetch traces that fill WallContact and FloorContact, probe traces use their EProbe. */
+	static constexpr uint32 PrefetchWallContact = FMovementProbeBatch::Probe_Num;
+	static constexpr uint32 PrefetchFloorContact = FMovementProbeBatch::Probe_Num + 1;
+
+	/** Whether this component is registered with USurvivalMovementBatchSubsystem. */
+	bool bBatchedProbes = false;
+
 	/** Accumulator used on the server to track total location error from client corrections. */
 	float AccumulatedClientLocationError = 0.f;
 
@@ -462,17 +989,68 @@ protected:
 	/** Debugging counter for the total bits sent to the server (used to calculate bandwidth usage). */
 	int64 TotalBitsSent = 0;
 
-	/** Whether a dash is triggered on the proxy (replicated to non-owning clients). */
-	UPROPERTY(ReplicatedUsing=OnRep_Dash)
-	bool Proxy_bDash;
+	/** Number of client moves the server has error checked, used to force corrections during benchmarks. */
+	int32 ServerMovesCheckedCount = 0;
+
+	/**
+	 * Error budget left before the server stops absorbing position error, see ServerPositionErrorBudget.
+	 * Only used without a client connection, client budgets are kept per connection by USurvivalMovementValidationSubsystem.
+	 */
+	float ServerPositionErrorBudgetLeft = 0.f;
+
+	/** Counters the server gathers between validation summaries. */
+	struct FServerValidationTelemetry
+	{
+		int32 MovesChecked = 0;
+		int32 CorrectionsSent = 0;
+		int32 ErrorsAbsorbed = 0;
+		/** Client moves whose transition or wall side disagreed with ours, left to the position check to correct. */
+		int32 StateMismatches = 0;
+		int32 RejectedDashes = 0;
+		float MaxLocationError = 0.f;
+		double LastReportTime = 0.0;
+	};
+
+	/** Validation counters since the last summary. */
+	FServerValidationTelemetry ServerValidationTelemetry;
+
+	/** One-off cosmetic events sent to simulated proxies in a Multicast_CosmeticEvents mask. */
+	enum ECosmeticEvent : uint8
+	{
+		COSMETIC_Dash			= 0x01,
+		COSMETIC_ShortMantle	= 0x02,
+		COSMETIC_TallMantle		= 0x04,
+	};
 
-	/** Whether a short mantle is triggered on the proxy (replicated to non-owning clients). */
-	UPROPERTY(ReplicatedUsing=OnRep_ShortMantle)
-	bool Proxy_bShortMantle;
+	/** ECosmeticEvent bits raised on the server this tick, sent together by TickComponent. */
+	uint8 PendingCosmeticEvents = 0;
 
-	/** Whether a tall mantle is triggered on the proxy (replicated to non-owning clients). */
-	UPROPERTY(ReplicatedUsing=OnRep_TallMantle)
-	bool Proxy_bTallMantle;
+	/** The server's wall-run side, so proxies do not have to trace for it (replicated to non-owning clients). */
+	UPROPERTY(ReplicatedUsing=OnRep_WallRunIsRight)
+	bool Proxy_bWallRunIsRight;
+
+	/** Whether this simulated proxy is far enough from the local view to run the low detail path, updated every tick. */
+	bool bProxyLowDetail = false;
+
+	/** Tick rate tiers set from the significance manager. */
+	enum ESignificanceLevel : uint8
+	{
+		Significance_Minimal,
+		Significance_Reduced,
+		Significance_Full
+	};
+
+	/** The tier this component last applied. */
+	ESignificanceLevel SignificanceLevel = Significance_Full;
+
+	/** Set below full significance, slide, prone and wall run then simulate each tick in as few steps as GetSurvivalSimulationTimeStep allows. */
+	bool bCoarseSimulation = false;
+
+	/** Holds the component at full significance whatever its distance, see SetForceFullSignificance. */
+	bool bForceFullSignificance = false;
+
+	/** Whether this component is registered with the significance manager. */
+	bool bSignificanceRegistered = false;
 
 public:
 
@@ -498,6 +1076,20 @@ public:
 	 */
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
+	/**
+	 * Rebuilds the constants derived from the tuning properties.
+	 * Call after changing tuning properties at runtime.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Character Movement")
+	void RefreshDerivedConstants();
+
+	/**
+	 * Rebakes the tuning curves the movement code samples.
+	 * Call after assigning a different curve asset or editing its keys at runtime.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Character Movement")
+	void RefreshTuningCurves();
+
 protected:
 	/**
 	 * Overridden from UActorComponent. Called when component is initialized, 
@@ -505,6 +1097,45 @@ protected:
 	 */
 	virtual void InitializeComponent() override;
 
+	/**
+	 * Registers server controlled AI characters with USurvivalMovementBatchSubsystem and the significance manager, see RefreshControllerRegistration.
+	 */
+	virtual void BeginPlay() override;
+
+	/**
+	 * Unregisters from USurvivalMovementBatchSubsystem and the significance manager.
+	 * @param EndPlayReason Why play is ending.
+	 */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+public:
+	/**
+	 * Registers with or unregisters from USurvivalMovementBatchSubsystem and the significance manager, depending on whether
+	 * the character is server controlled AI. Called from BeginPlay and by AZippyCharacter whenever its controller changes.
+	 */
+	void RefreshControllerRegistration();
+
+protected:
+	/**
+	 * Registers with or unregisters from USurvivalMovementBatchSubsystem.
+	 * @param bRegister True to register, false to unregister.
+	 */
+	void SetBatchedProbesRegistered(bool bRegister);
+
+	/**
+	 * Registers with or unregisters from the significance manager, going back to full significance when unregistering.
+	 * @param bRegister True to register, false to unregister.
+	 */
+	void SetSignificanceRegistered(bool bRegister);
+
+#if WITH_EDITOR
+	/**
+	 * Rebuilds the derived constants when a tuning property is edited.
+	 * @param PropertyChangedEvent The property that changed.
+	 */
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
 public:
 
 	/**
@@ -566,6 +1197,29 @@ protected:
 	 */
 	virtual void UpdateFromCompressedFlags(uint8 Flags) override;
 
+	/**
+	 * Applies the survival flags of the move being processed on the server before performing it.
+	 * @param ClientTimeStamp The client timestamp of the move.
+	 * @param DeltaTime How long the move took on the client.
+	 * @param CompressedFlags The compressed flags of the move.
+	 * @param NewAccel The acceleration of the move.
+	 */
+	virtual void MoveAutonomous(float ClientTimeStamp, float DeltaTime, uint8 CompressedFlags, const FVector& NewAccel) override;
+
+	/**
+	 * Takes the input bits of a move's FSurvivalNetworkMoveData::ESurvivalFlags, the rest of the flags are state the server decides.
+	 * @param SurvivalFlags The survival flags of the move.
+	 */
+	void ApplySurvivalInputFlags(uint8 SurvivalFlags);
+
+	/**
+	 * Rounds an acceleration to the precision it is sent to the server with in the current movement mode.
+	 * The saved move keeps this rounded value, so the client simulates with exactly what the server receives.
+	 * @param InAccel The acceleration to round.
+	 * @return The rounded acceleration.
+	 */
+	virtual FVector RoundAcceleration(FVector InAccel) const override;
+
 	/**
 	 * Called on client correction from server, increments correction count and
 	 * calls the parent method to finalize correction logic.
@@ -615,6 +1269,31 @@ protected:
 	 */
 	virtual void PhysCustom(float deltaTime, int32 Iterations) override;
 
+	/**
+	 * Runs the physics function for the current custom movement mode.
+	 * @param deltaTime Time step for this movement update.
+	 * @param Iterations Count of how many sub-steps have been processed so far.
+	 */
+	void PhysSurvivalCustom(float deltaTime, int32 Iterations);
+
+	/**
+	 * Adds deltaTime to the fixed step accumulator and simulates as many whole fixed steps as it holds.
+	 * Hands the leftover time to the new mode if a step leaves the fixed step modes.
+	 * @param deltaTime Time step for this movement update.
+	 * @param Iterations Count of how many sub-steps have been processed so far.
+	 */
+	void PhysFixedStep(float deltaTime, int32 Iterations);
+
+	/**
+	 * @return True if the current movement mode simulates in fixed steps.
+	 */
+	bool IsInFixedStepMode() const;
+
+	/**
+	 * Offsets the mesh of the locally controlled character to where it would be between the last two fixed steps.
+	 */
+	void UpdateFixedStepVisuals();
+
 	/**
 	 * Called every frame after movement is updated, to record the current crouch state
 	 * or perform any additional movement updates before finishing the tick.
@@ -633,8 +1312,26 @@ protected:
 	virtual void OnMovementModeChanged(EMovementMode PreviousMovementMode, uint8 PreviousCustomMode) override;
 
 	/**
-	 * Validates client position against the server, accumulates location error
-	 * for debugging, and then calls the parent method.
+	 * Simulates a simulated proxy. Low detail proxies skip the extrapolation entirely and only apply
+	 * replicated movement mode changes, leaving the network smoothing to interpolate between updates.
+	 * @param DeltaTime Time step for this movement update.
+	 */
+	virtual void SimulateMovement(float DeltaTime) override;
+
+	/**
+	 * Runs the movement for one tick or one replayed move, timed for the movement benchmark.
+	 * @param DeltaTime Time step for this movement update.
+	 */
+	virtual void PerformMovement(float DeltaTime) override;
+
+	/**
+	 * Replays the unacknowledged saved moves after a correction, timed for the movement benchmark.
+	 * @return Whether the replay was performed.
+	 */
+	virtual bool ClientUpdatePositionAfterServerUpdate() override;
+
+	/**
+	 * Validates client position against the server through the parent method and ServerExceedsAllowablePositionError.
 	 * @param ClientTimeStamp The client timestamp for the move.
 	 * @param DeltaTime How long this move took on the client.
 	 * @param Accel The acceleration input for this move.
@@ -648,12 +1345,54 @@ protected:
 	virtual bool ServerCheckClientError(float ClientTimeStamp, float DeltaTime, const FVector& Accel, const FVector& ClientWorldLocation,
 		 const FVector& RelativeClientLocation, UPrimitiveComponent* ClientMovementBase, FName ClientBaseBoneName, uint8 ClientMovementMode) override;
 
+	/**
+	 * Checks the client position against the tolerance for the current mode. Errors between the tolerance and
+	 * ServerMaxPositionTolerance are absorbed by the error budget instead of sending a correction straight away.
+	 * @param ClientTimeStamp The client timestamp for the move.
+	 * @param DeltaTime How long this move took on the client.
+	 * @param Accel The acceleration input for this move.
+	 * @param ClientWorldLocation The location the client reported.
+	 * @param RelativeClientLocation The relative client location (if base relative).
+	 * @param ClientMovementBase The component the client believes they're standing on.
+	 * @param ClientBaseBoneName The bone name for that base if it’s a skeletal mesh.
+	 * @param ClientMovementMode The movement mode the client is using.
+	 * @return True if the server should correct the client.
+	 */
+	virtual bool ServerExceedsAllowablePositionError(float ClientTimeStamp, float DeltaTime, const FVector& Accel, const FVector& ClientWorldLocation,
+		 const FVector& RelativeClientLocation, UPrimitiveComponent* ClientMovementBase, FName ClientBaseBoneName, uint8 ClientMovementMode) override;
+
+	/**
+	 * @return The position error the server tolerates in the current movement mode.
+	 */
+	float GetServerPositionTolerance() const;
+
+	/**
+	 * @return The error budget left for the owning client connection, started full the first time the connection is checked.
+	 */
+	float& ResolveServerPositionErrorBudget();
+
+	/**
+	 * @return The error budget left for the owning client connection, for logging.
+	 */
+	float GetServerPositionErrorBudgetLeft() const;
+
+	/**
+	 * Logs the validation counters gathered since the last summary and resets them, at most once every ServerValidationReportInterval.
+	 */
+	void ReportServerValidationTelemetry();
+
 	/**
 	 * Used for packing custom movement data into a bitstream before sending it
 	 * to the server. This allows partial manual serialization of movement data,
 	 * including extra flags for sprint, slide, dash, etc.
 	 */
 	FNetBitWriter SurvivalServerMoveBitWriter;
+
+	/** Packed move bits sent to the server, reused between moves so the bit array is not reallocated each send. */
+	FCharacterServerMovePackedBits SurvivalServerMovePackedBits;
+
+	/** Storage for the move data sent by CallServerMovePacked and read on the server. */
+	FSurvivalNetworkMoveDataContainer SurvivalMoveDataContainer;
 	
 	/**
 	 * Packs custom move data into a bitstream for server RPC, including our extra slide/sprint/etc. flags.
@@ -685,22 +1424,37 @@ private:
 	bool CanSlide() const;
 
 	/**
-	 * Physics logic for sliding, including custom friction, gravity, and transitions out of slide.
+	 * The PhysWalking loop shared by the ground modes. TGroundModel supplies what differs between them:
+	 * CanStart(Move, deltaTime, Iterations) to bail out before moving, ApplyForces(Move, deltaTime, timeTick) for the
+	 * mode's forces, friction and acceleration each substep, Finish(Move) after the loop, and the bCatchAir and
+	 * bVelocityFromWalkableFloorOnly flags.
 	 * @param deltaTime The time step for this tick.
 	 * @param Iterations Count of how many sub-steps have been processed so far.
 	 */
-	void PhysSlide(float deltaTime, int32 Iterations);
+	template<typename TGroundModel>
+	void PhysGround(float deltaTime, int32 Iterations);
+
+	/** Slide's model for PhysGround. */
+	struct FSlideGroundModel;
+
+	/** Prone's model for PhysGround. */
+	struct FProneGroundModel;
 
 	/**
-	 * Called when the player tries to enter prone. We set Safe_bWantsToProne to true for the next check.
+	 * Carries the floor over from before a ground move when bReuseAdjacentFloor allows it and the capsule still rests on the same face.
+	 * @param OldFloor The floor before the move.
+	 * @param OldLocation Where the move started.
+	 * @param Delta The move that was asked for.
+	 * @return True if CurrentFloor was set without a floor sweep.
 	 */
-	FORCEINLINE void OnTryEnterProne() { Safe_bWantsToProne = true; }
+	bool TryReuseAdjacentFloor(const FFindFloorResult& OldFloor, const FVector& OldLocation, const FVector& Delta);
 
 	/**
-	 * Server RPC to confirm entering prone. Avoids cheating or mismatch across clients/servers.
+	 * Physics logic for sliding, including custom friction, gravity, and transitions out of slide.
+	 * @param deltaTime The time step for this tick.
+	 * @param Iterations Count of how many sub-steps have been processed so far.
 	 */
-	UFUNCTION(Server, Reliable)
-	void Server_EnterProne();
+	void PhysSlide(float deltaTime, int32 Iterations);
 
 	/**
 	 * Sets the state to prone (if valid), sets crouch to true, and applies an impulse if transitioning from slide.
@@ -727,12 +1481,6 @@ private:
 	 */
 	void PhysProne(float deltaTime, int32 Iterations);
 
-	/**
-	 * Called after the dash button is pressed while dash is on cooldown. 
-	 * When this finishes, Safe_bWantsToDash is set to true so the character can dash again.
-	 */
-	FORCEINLINE void OnDashCooldownFinished();
-
 	/**
 	 * Checks if the character can start a dash (e.g., not crouched, or is falling).
 	 * @return True if conditions are valid for a dash.
@@ -752,6 +1500,18 @@ private:
 	 */
 	bool TryMantle();
 
+	/**
+	 * Looks for a ledge in front of the character: a steep enough wall, a flat enough surface on top within reach, and room for the capsule.
+	 * @param BaseLoc The bottom of the capsule.
+	 * @param Fwd The character's facing, flattened.
+	 * @param CheckDistance How far in front the wall may be.
+	 * @param OutFrontHit The hit on the wall.
+	 * @param OutSurfaceHit The hit on the surface on top.
+	 * @param OutHeight Height of the surface above BaseLoc.
+	 * @return True if a ledge was found.
+	 */
+	bool FindMantleSurface(const FVector& BaseLoc, const FVector& Fwd, float CheckDistance, FHitResult& OutFrontHit, FHitResult& OutSurfaceHit, float& OutHeight);
+
 	/**
 	 * Calculates the starting location for the root-motion mantle move,
 	 * choosing between short or tall mantle offsets.
@@ -779,16 +1539,43 @@ private:
 	/**
 	 * Checks if the character can hang onto a ledge or climb point by line tracing forward.
 	 * If valid, initiates a root-motion transition.
+	 * @param bChained True when started as the follow-up of another transition, which skips the falling check.
 	 * @return True if a hang is successfully started.
 	 */
-	bool TryHang();
+	bool TryHang(bool bChained = false);
 
 	/**
 	 * Checks if the character can climb by tracing forward, verifying no floor beneath, etc.
+	 * @param bChained True when started as the follow-up of another transition, which skips the falling check.
 	 * @return True if a climb is successfully started.
 	 */
-	bool TryClimb();
+	bool TryClimb(bool bChained = false);
+
+	/**
+	 * Queues a transition to start once the one in progress finishes. Replaces any transition already queued.
+	 * Pressing jump during a mantle queues a hang and pressing it during a hang queues a climb.
+	 * @param Transition The transition to queue, Hang or Climb.
+	 */
+	void QueueTransition(ESurvivalTransition Transition);
+
+	/**
+	 * Takes a free source from TransitionRMSPool and resets it to defaults, allocating a new one only if all of them are in use.
+	 * @return The source to configure and pass to ApplyRootMotionSource.
+	 */
+	TSharedPtr<FRootMotionSource_MoveToForce> AcquireTransitionRMS();
+
+	/**
+	 * Runs one of the transition probes and records its failure for the saved move.
+	 * While replaying a move that failed this probe before from about the same location, fails without touching the world.
+	 * @param Probe The probe to run.
+	 * @return True if the probe started its transition or movement mode.
+	 */
+	bool TryProbe(EProbeDecision Probe);
 
+	/**
+	 * Applies the end of the transition in progress (montage or movement mode), then starts the queued follow-up if there is one.
+	 */
+	void FinishTransition();
 	/**
 	 * Physics logic for climbing, updating velocity in line with the wall surface, 
 	 * applying wall attraction, and transitioning out if invalid.
@@ -797,11 +1584,138 @@ private:
 	 */
 	void PhysClimb(float deltaTime, int32 Iterations);
 
+	/**
+	 * Returns the hit for one probe of the current batch, tracing it only if this batch has not resolved it yet.
+	 * Starts a new batch first if the capsule moved past ProbeReuseTolerance since the batch was gathered.
+	 * @param Probe The FMovementProbeBatch::EProbe slot to resolve.
+	 * @param Start Trace start, only used if the probe has to be traced.
+	 * @param End Trace end, only used if the probe has to be traced.
+	 * @return The cached trace result for this probe.
+	 */
+	const FHitResult& ResolveProbe(int32 Probe, const FVector& Start, const FVector& End);
+
+	/**
+	 * @param Hit A probe trace result.
+	 * @return True if the hit can be kept in the batch, false if it is on geometry that can move and must be traced again.
+	 */
+	static bool IsProbeHitReusable(const FHitResult& Hit);
+
+	/**
+	 * Drops every probe of the current batch so they are traced again on next use.
+	 */
+	void InvalidateProbeBatch();
+
+	/**
+	 * Resolves the forward probe shared by TryHang and TryClimb.
+	 * Callers compare the hit distance against their own reach.
+	 * @return The cached forward trace result.
+	 */
+	const FHitResult& ResolveForwardProbe();
+
+	/**
+	 * Computes the trace of a probe from the current capsule, for the probes that do not depend on the move being made.
+	 * @param Probe Probe_WallRunFloor, Probe_WallRunLeft, Probe_WallRunRight or Probe_Forward.
+	 * @param OutStart Receives the trace start.
+	 * @param OutEnd Receives the trace end.
+	 */
+	void GetProbeSegment(int32 Probe, FVector& OutStart, FVector& OutEnd) const;
+
+	/**
+	 * Called by the async trace system with a trace queued by PrefetchProbes, stores it where the next tick will look for it.
+	 * @param TraceHandle The handle of the finished trace.
+	 * @param TraceDatum The trace result, UserData says which probe or contact it is for.
+	 */
+	void OnPrefetchTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+
+	/** Writes the buffered presses into the input flags ahead of this tick's move. Called on the locally controlled character. */
+	void ApplyBufferedInputs();
+
+	/**
+	 * Marks a buffered press as acted on so it is not applied again. Ignored while replaying moves.
+	 * @param Input The action the movement performed.
+	 */
+	void ConsumeBufferedPress(EBufferedInput Input);
+
+	/**
+	 * Works out the significance tier for one player view. Called by the significance manager, possibly off the game thread.
+	 * @param Viewpoint The player view.
+	 * @return The ESignificanceLevel for that view.
+	 */
+	float CalculateSignificance(const FTransform& Viewpoint) const;
+
+	/**
+	 * Applies a significance tier from the significance manager: sets the tick interval and coarse simulation.
+	 * @param Significance The ESignificanceLevel, the highest over all player views.
+	 */
+	void ApplySignificance(float Significance);
+
+	/**
+	 * Substep length for slide, prone and wall run. While simulating coarsely a single step of up to MinimalTickInterval,
+	 * or MaxSimulationTimeStep if that is longer.
+	 * @param RemainingTime Time left to simulate this tick.
+	 * @param Iterations Count of how many sub-steps have been processed so far.
+	 * @return The time to simulate in the next substep.
+	 */
+	float GetSurvivalSimulationTimeStep(float RemainingTime, int32 Iterations) const;
+
+	/**
+	 * Sweeps the capsule from Start to End with the updated component's collision, without moving it.
+	 * @param Start Capsule center to sweep from.
+	 * @param End Capsule center to sweep to.
+	 * @return True if nothing blocks the capsule along the way.
+	 */
+	bool IsCapsulePathClear(const FVector& Start, const FVector& End);
+
+	/**
+	 * Tests whether the capsule would overlap anything blocking at Location.
+	 * @param Location Capsule center to test.
+	 * @return True if the capsule fits at Location.
+	 */
+	bool IsCapsuleClearAt(const FVector& Location);
+
+	/**
+	 * Reuses a surface contact if the capsule has not moved since it was traced from, otherwise traces it again.
+	 * A contact that previously hit is first re-checked with a short trace just past the predicted wall distance,
+	 * so landing and running off the end of a wall are noticed on the substep they happen.
+	 * @param Contact The contact record to reuse or refresh.
+	 * @param Direction The normalized direction to trace in from the capsule center.
+	 * @param TraceLength How far to trace.
+	 * @return The up to date contact.
+	 */
+	const FSurfaceContact& ResolveSurfaceContact(FSurfaceContact& Contact, const FVector& Direction, float TraceLength);
+
+	/**
+	 * Drops the wall and floor contacts so they are traced again on next use.
+	 */
+	void InvalidateSurfaceContacts();
+
+	/**
+	 * Moves along a wall with the wall attraction folded into the same sweep, sliding along whatever is hit.
+	 * The attraction stops short of the wall, so a clean move along it is a single sweep.
+	 * Drops the surface contacts if the move hits a component other than the wall.
+	 * @param Delta The move along the wall.
+	 * @param Wall The contact of the wall being moved along.
+	 * @param DeltaTime The time step of the move, used to scale the attraction.
+	 */
+	void MoveAlongWall(const FVector& Delta, const FSurfaceContact& Wall, float DeltaTime);
+
 	/**
 	 * @return True if this component is currently on the server (HasAuthority).
 	 */
 	FORCEINLINE bool IsServer() const;
 
+	/**
+	 * @return True if a client predicts this character's moves, so the server, that client and its replays must simulate them identically.
+	 */
+	bool IsNetworkPredicted() const;
+
+	/**
+	 * Whether the current movement mode is a custom mode that moves the character along a predictable path
+	 * (slide, prone, wall run, hang, climb), so consecutive saved moves can be combined more aggressively.
+	 * @return True if saved moves made now should use the steady mode combine thresholds.
+	 */
+	bool IsInSteadyCombineMode() const;
+
 	/**
 	 * @return The capsule radius of the owning character.
 	 */
@@ -839,30 +1753,53 @@ public:
 	FORCEINLINE void StopSlide();
 
 	/** @TODO Replace this function by just overriding the Crouch/Uncrouch function in the character class.
-	 * Toggles crouch and sets a timer to enter prone if crouch is held long enough.
+	 * Toggles crouch and starts holding it, the movement enters prone if it is held for ProneEnterHoldDuration.
 	 */
 	UFUNCTION(BlueprintCallable)
 	FORCEINLINE void StartCrouch();
 
 	/** @TODO Replace this function by just overriding the Crouch/Uncrouch function in the character class.
-	 * Cancels the timer for entering prone if crouch is released.
+	 * Releases the crouch hold so prone is not entered.
 	 */
 	UFUNCTION(BlueprintCallable)
 	FORCEINLINE void StopCrouch();
 
 	/**
-	 * Initiates dash logic if not on cooldown, or starts a timer to try again 
-	 * if the cooldown will expire soon.
+	 * Signals that the player wants to dash. Performed by the movement as soon as the dash cooldown has run out.
 	 */
 	UFUNCTION(BlueprintCallable)
 	FORCEINLINE void StartDash();
 
 	/**
-	 * Clears the dash cooldown timer, unsets the dash flag if dash input is released.
+	 * Unsets the dash flag if dash input is released.
 	 */
 	UFUNCTION(BlueprintCallable)
 	FORCEINLINE void StopDash();
 
+	/** Actions BufferPress can buffer. */
+	enum EBufferedInput : uint8
+	{
+		INPUT_Jump,
+		INPUT_Slide,
+		INPUT_Dash,
+		INPUT_Prone,
+		INPUT_MAX
+	};
+
+	/**
+	 * Buffers a press for the movement, timestamped so it stays pending for InputBufferDuration.
+	 * A press and release between two ticks still reaches a move, and presses are held until the movement acts on them.
+	 * Only meant for the locally controlled character.
+	 * @param Input The action pressed.
+	 */
+	void BufferPress(EBufferedInput Input);
+
+	/**
+	 * Releases a buffered action. A press that is still pending is kept until it expires or is consumed.
+	 * @param Input The action released.
+	 */
+	void BufferRelease(EBufferedInput Input);
+
 	/**
 	 * Signals that the player wants to climb or continue climbing if possible. 
 	 * Sets bWantsToCrouch if in midair or already climbing.
@@ -932,30 +1869,70 @@ public:
 
 	/**
 	 * Called to gather properties that need replication. 
-	 * Ensures dash and mantle booleans replicate to non-owning clients.
+	 * Ensures the wall-run side replicates to non-owning clients.
 	 * @param OutLifetimeProps The array of FLifetimeProperty definitions to update.
 	 */
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
 private:
 	/**
-	 * Called when Proxy_bDash is replicated to remote clients.
-	 * Plays the dash montage and broadcasts the dash start event.
+	 * Sends the cosmetic events raised this tick to simulated proxies in one unreliable multicast.
+	 * Unreliable multicasts are not sent to connections beyond the owner's net cull distance.
+	 * @param Events The ECosmeticEvent bits raised this tick.
 	 */
-	UFUNCTION()
-	void OnRep_Dash();
+	UFUNCTION(NetMulticast, Unreliable)
+	void Multicast_CosmeticEvents(uint8 Events);
 
 	/**
-	 * Called when Proxy_bShortMantle is replicated to remote clients.
-	 * Plays the ProxyShortMantleMontage.
+	 * Called when Proxy_bWallRunIsRight is replicated to remote clients.
+	 * Takes the wall-run side from the server.
 	 */
 	UFUNCTION()
-	void OnRep_ShortMantle();
+	void OnRep_WallRunIsRight();
 
 	/**
-	 * Called when Proxy_bTallMantle is replicated to remote clients.
-	 * Plays the ProxyTallMantleMontage.
+	 * Decides whether this simulated proxy should run the low detail path this tick.
+	 * @return True if the proxy is further than ProxyLowDetailDistance from the local view.
 	 */
-	UFUNCTION()
-	void OnRep_TallMantle();
+	bool ComputeProxyLowDetail() const;
+
+public:
+	/**
+	 * @return True if this is a simulated proxy running the low detail path.
+	 */
+	UFUNCTION(BlueprintPure)
+	FORCEINLINE bool IsProxyLowDetail() const { return bProxyLowDetail; }
+
+	/**
+	 * Holds this character at full tick rate and simulation quality, or hands it back to the significance manager.
+	 * @param bForce True to snap to full significance right away.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Character Movement")
+	void SetForceFullSignificance(bool bForce);
+
+	/**
+	 * Runs a captured move again the way the server would run it, for SurvivalMovementReplay.
+	 * @param Record The captured move.
+	 */
+	void ReplayCapturedMove(const FSurvivalMoveCaptureRecord& Record);
+
+	/**
+	 * Captures a move performed by this client. Called by the saved move after it was first performed.
+	 * @param Move The move performed.
+	 */
+	void CaptureMove(const FSavedMove_SurvivalCharacter& Move);
+
+	/**
+	 * Queues async traces for the probes and surface contacts the next tick in the current mode is going to need.
+	 * Called at the end of the frame by USurvivalMovementBatchSubsystem.
+	 */
+	void PrefetchProbes();
+
+#if SURVIVAL_MOVEMENT_DEBUG
+	/**
+	 * Describes the movement state and network counters for the zippy.Movement.Debug stats panel.
+	 * @param OutLines Receives one line of text per stat.
+	 */
+	void GetDebugLines(TArray<FString>& OutLines) const;
+#endif
 };
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Zippy.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SurvivalMovementBatch.generated.h"
+
+/**
+ * Batches the environment probes of server controlled AI characters that opt in with bBatchServerProbes.
+ * At the end of each frame every registered component queues the traces its next tick is going to make as async traces,
+ * which the engine runs across its worker threads. The results are in the probe batch and surface contacts before the
+ * components tick on the next frame, leaving only the sweeps of the moves themselves on the game thread.
+ */
+UCLASS()
+class ZIPPY_API USurvivalMovementBatchSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return Components.Num() > 0; }
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * Starts prefetching probes for a component.
+	 * @param Component The server side movement component of an AI character.
+	 */
+	void Register(USurvivalCharacterMovementComponent* Component);
+
+	/**
+	 * Stops prefetching probes for a component.
+	 * @param Component A component passed to Register.
+	 */
+	void Unregister(USurvivalCharacterMovementComponent* Component);
+
+private:
+	TArray<TWeakObjectPtr<USurvivalCharacterMovementComponent>> Components;
+};
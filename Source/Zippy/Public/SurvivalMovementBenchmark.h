@@ -0,0 +1,137 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Zippy.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SurvivalMovementStats.h"
+#include "SurvivalMovementBenchmark.generated.h"
+
+#if SURVIVAL_MOVEMENT_STATS
+/**
+ * What one benchmark run measured, diffed from the movement stat totals of the whole process.
+ * Under PIE the server and every client share the process, so PerformMovement is counted on both sides.
+ */
+struct ZIPPY_API FSurvivalMovementBenchmarkResults
+{
+	int32 NumCharacters = 0;
+	double Seconds = 0.0;
+	uint64 Frames = 0;
+
+	int64 PerformMovements = 0;
+	double NsPerMovement = 0.0;
+	double TracesPerTick = 0.0;
+
+	int64 ServerMovesSent = 0;
+	double BitsPerMove = 0.0;
+
+	int64 Replays = 0;
+	double NsPerReplay = 0.0;
+	int64 ServerCorrections = 0;
+	int64 ClientCorrections = 0;
+
+	/**
+	 * Formats the results for the log or an automation report.
+	 * @param OutLines Receives one line per measurement.
+	 */
+	void GetLines(TArray<FString>& OutLines) const;
+};
+#endif
+
+/**
+ * Movement benchmark, started with "zippy.Movement.Benchmark [Seconds]" or by the Zippy.Movement.Benchmark automation test.
+ * Drives the locally controlled autonomous proxy of every net client world in the process with a scripted loop of
+ * sprint, slide, dash, mantle, wall run and climb inputs. The inputs go through the regular saved move pipeline,
+ * so every tick is replicated with ReplicateMoveToServer and checked by the server, and
+ * zippy.Movement.Benchmark.ForceCorrectionInterval forces corrections to replay.
+ * Logs ns per PerformMovement, traces per tick, bits per move and replay cost when it stops.
+ * Not available in shipping builds.
+ */
+UCLASS()
+class ZIPPY_API USurvivalMovementBenchmarkSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return bRunning; }
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * Starts driving the characters of every net client world, stopping any running benchmark first.
+	 * @param Duration How long to run for before logging the results.
+	 * @return How many characters are being driven, zero if there were none to drive.
+	 */
+	static int32 StartBenchmark(float Duration);
+
+	/**
+	 * Stops driving every character and logs the results of the running benchmark.
+	 */
+	static void StopBenchmark();
+
+	/** @return True while a benchmark is running. */
+	static bool IsBenchmarkRunning();
+
+	/** @return How many characters StartBenchmark would drive right now. */
+	static int32 GetNumDrivableCharacters();
+
+#if SURVIVAL_MOVEMENT_STATS
+	/** @return The results of the last benchmark that stopped. */
+	static const FSurvivalMovementBenchmarkResults& GetLastResults();
+#endif
+
+	/**
+	 * @return Every how many checked client moves the server forces a correction, zero when not forcing any.
+	 */
+	static int32 GetForcedCorrectionInterval();
+
+private:
+	/** The scripted inputs each character cycles through, one per StepDuration. */
+	enum EScriptStep : uint8
+	{
+		Step_Sprint,
+		Step_Slide,
+		Step_Dash,
+		Step_Mantle,
+		Step_WallRun,
+		Step_Climb,
+		Step_Num
+	};
+
+	/** How long each scripted step lasts. */
+	static constexpr float StepDuration = 1.5f;
+
+	/**
+	 * @param World The world to search.
+	 * @return The locally controlled autonomous proxies of the world, empty unless it is a net client.
+	 */
+	static TArray<AZippyCharacter*> FindDrivableCharacters(const UWorld* World);
+
+	/**
+	 * Starts driving this world's characters.
+	 * @param Duration How long to drive them for.
+	 * @return How many characters are being driven.
+	 */
+	int32 StartDriving(float Duration);
+
+	/**
+	 * Releases every scripted input and stops driving this world's characters.
+	 */
+	void StopDriving();
+
+	/**
+	 * Feeds the inputs of the scripted step to a character, pressing and releasing on step edges.
+	 * @param Character The character to drive.
+	 * @param Step The step the character is in.
+	 * @param bStepStarted True on the first tick of the step.
+	 */
+	void DriveCharacter(AZippyCharacter* Character, EScriptStep Step, bool bStepStarted) const;
+
+	TArray<TWeakObjectPtr<AZippyCharacter>> Characters;
+	TArray<uint8> CharacterSteps;
+
+	bool bRunning = false;
+	float ElapsedTime = 0.f;
+	float BenchmarkDuration = 0.f;
+};
@@ -0,0 +1,162 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/CircularQueue.h"
+#include "HAL/Runnable.h"
+#include <atomic>
+
+class IFileHandle;
+class FRunnableThread;
+
+// Movement capture, switched on with "zippy.Movement.Capture". Streams the local player's moves and the corrections
+// it receives to Saved/MovementCaptures for SurvivalMovementReplay to run again offline.
+
+/** One captured move or correction. Fixed size so the capture file can be a ring of records. */
+struct FSurvivalMoveCaptureRecord
+{
+	enum EType : uint8
+	{
+		Type_Move,
+		Type_Correction
+	};
+
+	/** Order records were captured in, the file wraps so file order is not capture order. */
+	uint32 Sequence = 0;
+	uint8 Type = Type_Move;
+
+	/** Move: the saved move's compressed flags and FSurvivalNetworkMoveData::ESurvivalFlags. */
+	uint8 CompressedFlags = 0;
+	uint8 SurvivalFlags = 0;
+
+	/** Move: packed movement mode at the start and end of the move. Correction: the server's mode. */
+	uint8 StartPackedMode = 0;
+	uint8 EndPackedMode = 0;
+
+	/** Move: the ESurvivalTransition the move started in. */
+	uint8 Transition = 0;
+
+	float TimeStamp = 0.f;
+	float DeltaTime = 0.f;
+
+	/** Move: the acceleration sent to the server. */
+	FVector3f Acceleration = FVector3f::ZeroVector;
+
+	/** Move: location and velocity the move started from. Correction: the server's location and velocity. */
+	FVector3f Location = FVector3f::ZeroVector;
+	FVector3f Velocity = FVector3f::ZeroVector;
+
+	/** Move: actor rotation the move started from and the control rotation it was sent with. Correction: the client's rotation. */
+	FRotator3f Rotation = FRotator3f::ZeroRotator;
+	FRotator3f ControlRotation = FRotator3f::ZeroRotator;
+
+	/** Move: location the move ended at on the client. */
+	FVector3f EndLocation = FVector3f::ZeroVector;
+
+	/** Move: movement state timed in move time at the start of the move. */
+	float CrouchHoldTime = 0.f;
+	float DashCooldownLeft = 0.f;
+};
+
+/** Start of every capture file. */
+struct FSurvivalMoveCaptureHeader
+{
+	static constexpr uint32 CaptureMagic = 0x315A4D43; // "CMZ1"
+	static constexpr uint32 CaptureVersion = 2;
+
+	uint32 Magic = CaptureMagic;
+	uint32 Version = CaptureVersion;
+	uint32 RecordSize = sizeof(FSurvivalMoveCaptureRecord);
+
+	/** Records dropped because the writer fell behind, written when the capture closes. */
+	uint32 Dropped = 0;
+
+	/** Package name of the map the capture was made in, null terminated. */
+	ANSICHAR MapName[128] = {};
+};
+
+/**
+ * Writes captured records to a ring file from a background thread.
+ * The game thread pushes into a lock free single producer single consumer queue, which the writer thread drains
+ * into the file in batches. If the queue is full the record is dropped and counted instead of blocking the game thread.
+ * Once the file reaches its size limit it wraps back to the first record, keeping the most recent part of the session.
+ * The last record is held back until the next one arrives, so a move that gets combined into the next one can be replaced
+ * by the combined move instead of being written twice.
+ */
+class ZIPPY_API FSurvivalMovementCaptureWriter : public FRunnable
+{
+public:
+	/**
+	 * Opens the capture file and starts the writer thread.
+	 * @param Filename The file to write.
+	 * @param MapName Package name of the current map, stored in the header.
+	 * @param MaxBytes Size the file wraps at.
+	 */
+	FSurvivalMovementCaptureWriter(const FString& Filename, const FString& MapName, int64 MaxBytes);
+	virtual ~FSurvivalMovementCaptureWriter() override;
+
+	/** @return Whether the file was opened and records are being written. */
+	bool IsOpen() const { return File.IsValid(); }
+
+	/**
+	 * Queues a record for writing. Game thread only.
+	 * @param Record The record.
+	 * @param bSupersedesLastMove True if Record is a move combined with the last move pushed, which it replaces.
+	 */
+	void Push(const FSurvivalMoveCaptureRecord& Record, bool bSupersedesLastMove = false);
+
+	/** @return Records dropped so far because the writer thread fell behind. */
+	int32 GetDropped() const { return Dropped; }
+
+	//~ FRunnable
+	virtual uint32 Run() override;
+	virtual void Stop() override { bStopping = true; }
+
+	/**
+	 * Reads a capture file back in capture order.
+	 * @param Filename The file to read.
+	 * @param OutHeader The capture header.
+	 * @param OutRecords The records, sorted by Sequence.
+	 * @return False if the file is missing or was written by a different version.
+	 */
+	static bool ReadCapture(const FString& Filename, FSurvivalMoveCaptureHeader& OutHeader, TArray<FSurvivalMoveCaptureRecord>& OutRecords);
+
+	/** @return The directory capture files are written to. */
+	static FString GetCaptureDir();
+
+private:
+	/** Writes every queued record to the file. Writer thread only, or once it has stopped. */
+	void Drain();
+
+	/** Queues the held back record, assigning its Sequence. Game thread only. */
+	void Enqueue(FSurvivalMoveCaptureRecord& Record);
+
+	/** Records waiting for the writer thread. */
+	static constexpr uint32 QueueCapacity = 4096;
+	TCircularQueue<FSurvivalMoveCaptureRecord> Queue;
+
+	TUniquePtr<IFileHandle> File;
+	FRunnableThread* Thread = nullptr;
+	std::atomic<bool> bStopping = false;
+
+	/** Game thread side. */
+	uint32 NextSequence = 0;
+	int32 Dropped = 0;
+	TOptional<FSurvivalMoveCaptureRecord> HeldRecord;
+	FSurvivalMoveCaptureHeader Header;
+
+	/** Writer thread side. */
+	int64 WriteOffset = 0;
+	int64 MaxRecordBytes = 0;
+};
+
+namespace SurvivalMovementCapture
+{
+	/**
+	 * Whether a session starting now should be captured: zippy.Movement.Capture is set and the session passed
+	 * the zippy.Movement.CaptureSampleRate roll.
+	 */
+	ZIPPY_API bool ShouldCaptureSession();
+
+	/** @return The size capture files wrap at, from zippy.Movement.CaptureMaxMB. */
+	ZIPPY_API int64 GetMaxBytes();
+}
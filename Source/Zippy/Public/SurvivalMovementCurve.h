@@ -0,0 +1,46 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UCurveFloat;
+
+/**
+ * A tuning curve baked into a small uniform table so the movement hot path samples it with one lerp
+ * instead of chasing the curve asset and searching its keys every substep.
+ * Covers the curve's key range, inputs outside it clamp to the end values.
+ */
+struct ZIPPY_API FSurvivalBakedCurve
+{
+	static constexpr int32 NumSamples = 32;
+
+	/**
+	 * Samples the curve into the table.
+	 * @param Curve The curve to bake, may be null.
+	 * @param DefaultValue Value every sample takes when there is no curve or it has no keys.
+	 */
+	void Bake(const UCurveFloat* Curve, float DefaultValue);
+
+	/**
+	 * @param Time The curve input.
+	 * @return The baked curve value at Time, linearly interpolated between the two nearest samples.
+	 */
+	FORCEINLINE float Sample(float Time) const
+	{
+		const float Position = FMath::Clamp((Time - MinTime) * SamplesPerTime, 0.f, float(NumSamples - 1));
+		const int32 Index = FMath::Min(FMath::TruncToInt32(Position), NumSamples - 2);
+		return FMath::Lerp(Samples[Index], Samples[Index + 1], Position - Index);
+	}
+
+	/** @return True if the last bake had a curve with keys to sample. */
+	bool IsBakedFromCurve() const { return bFromCurve; }
+
+private:
+	float MinTime = 0.f;
+
+	/** Table positions per unit of curve input, zero for a constant table. */
+	float SamplesPerTime = 0.f;
+
+	float Samples[NumSamples] = {};
+
+	bool bFromCurve = false;
+};
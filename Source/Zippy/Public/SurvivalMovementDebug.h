@@ -0,0 +1,48 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Zippy.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SurvivalMovementDebug.generated.h"
+
+// Movement debug drawing, switched on with "zippy.Movement.Debug". Compiled out wherever debug drawing is.
+#define SURVIVAL_MOVEMENT_DEBUG ENABLE_DRAW_DEBUG
+
+namespace SurvivalMovementDebug
+{
+	/** What zippy.Movement.Debug draws at each level. */
+	enum ELevel : int32
+	{
+		Level_Off,
+		Level_Probes,
+		Level_NetStats
+	};
+
+	/**
+	 * @return The current zippy.Movement.Debug level, always Level_Off when debug drawing is compiled out.
+	 */
+	ZIPPY_API int32 GetLevel();
+
+	/**
+	 * Whether probes run by a character should be drawn: debugging is on and the character is the local view target.
+	 * @param Character The character running the probes.
+	 * @return True if the character's probes should be drawn.
+	 */
+	ZIPPY_API bool ShouldDraw(const AActor* Character);
+}
+
+/**
+ * Draws the movement state and network stats of the viewed character while zippy.Movement.Debug is 2.
+ * Ticks only while that level is set, so it costs nothing when debugging is off. Not available where debug drawing is compiled out.
+ */
+UCLASS()
+class ZIPPY_API USurvivalMovementDebugSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+};
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SurvivalMovementReplayCommandlet.generated.h"
+
+/**
+ * Runs a zippy.Movement.Capture capture again headlessly against its map, to reproduce the CPU cost of the moves
+ * and where the simulation diverges from what the client recorded.
+ * Each move is run the way the server runs a client move, with its control rotation and move time counters.
+ * Captured corrections put the character back where the server said, as they did on the client.
+ * The world is not ticked, its clocks advance by each move's delta time.
+ *
+ * Usage: UnrealEditor-Cmd Zippy -run=SurvivalMovementReplay -Capture=<file> [-Character=<class path>] [-Tolerance=<cm>]
+ */
+UCLASS()
+class ZIPPY_API USurvivalMovementReplayCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	USurvivalMovementReplayCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
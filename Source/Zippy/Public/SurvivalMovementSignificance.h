@@ -0,0 +1,35 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Zippy.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SurvivalMovementSignificance.generated.h"
+
+/**
+ * Feeds the significance manager the view of every player this world knows of, so movement components registered
+ * with bUseMovementSignificance can lower their tick rate when no player is near them.
+ * On a server that is every connected player, on a client the local players.
+ */
+UCLASS()
+class ZIPPY_API USurvivalMovementSignificanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return NumRegistered > 0; }
+	virtual TStatId GetStatId() const override;
+
+	/** The significance manager tag movement components register under. */
+	static const FName SignificanceTag;
+
+	/** Called by movement components as they register with and unregister from the significance manager. */
+	void AddRegistered() { NumRegistered++; }
+	void RemoveRegistered() { NumRegistered--; }
+
+private:
+	int32 NumRegistered = 0;
+
+	/** Reused between ticks so gathering the views does not allocate. */
+	TArray<FTransform> Viewpoints;
+};
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+// Movement instrumentation (stat SurvivalMovement, the CSV profiler and Insights counters). Compiled out in shipping.
+#define SURVIVAL_MOVEMENT_STATS !UE_BUILD_SHIPPING
+
+#if SURVIVAL_MOVEMENT_STATS
+
+DECLARE_STATS_GROUP(TEXT("SurvivalMovement"), STATGROUP_SurvivalMovement, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("PhysSlide"), STAT_SurvivalMovement_PhysSlide, STATGROUP_SurvivalMovement, ZIPPY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("PhysProne"), STAT_SurvivalMovement_PhysProne, STATGROUP_SurvivalMovement, ZIPPY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("PhysWallRun"), STAT_SurvivalMovement_PhysWallRun, STATGROUP_SurvivalMovement, ZIPPY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("PhysClimb"), STAT_SurvivalMovement_PhysClimb, STATGROUP_SurvivalMovement, ZIPPY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("TryMantle"), STAT_SurvivalMovement_TryMantle, STATGROUP_SurvivalMovement, ZIPPY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("TryHang"), STAT_SurvivalMovement_TryHang, STATGROUP_SurvivalMovement, ZIPPY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("CallServerMovePacked"), STAT_SurvivalMovement_CallServerMovePacked, STATGROUP_SurvivalMovement, ZIPPY_API);
+
+CSV_DECLARE_CATEGORY_EXTERN(SurvivalMovement);
+
+// Times the enclosing scope under stat SurvivalMovement and the SurvivalMovement CSV category.
+#define SURVIVAL_SCOPE_CYCLE_COUNTER(Name) \
+	SCOPE_CYCLE_COUNTER(STAT_SurvivalMovement_##Name); \
+	CSV_SCOPED_TIMING_STAT(SurvivalMovement, Name)
+
+/**
+ * Frame totals for every survival movement component in the world, published once per frame
+ * as stat counters, CSV custom stats and Insights trace counters.
+ */
+namespace SurvivalMovementStats
+{
+	/** The movement modes trace counts are bucketed by. */
+	enum EMode : uint8
+	{
+		Mode_Walking,
+		Mode_Falling,
+		Mode_Slide,
+		Mode_Prone,
+		Mode_WallRun,
+		Mode_Hang,
+		Mode_Climb,
+		Mode_Other,
+		Mode_Num
+	};
+
+	/**
+	 * Maps a movement mode onto the bucket its traces are counted in.
+	 * @param MovementMode The EMovementMode of the component.
+	 * @param CustomMovementMode The ECustomMovementMode of the component.
+	 * @return The bucket to count in.
+	 */
+	ZIPPY_API EMode GetMode(uint8 MovementMode, uint8 CustomMovementMode);
+
+	/** Counts scene queries issued while in a movement mode. */
+	ZIPPY_API void CountTraces(EMode Mode, int32 Count);
+
+	/** Counts a move the server checked for error, and whether it needed a correction. */
+	ZIPPY_API void CountServerMoveChecked(bool bNeedsCorrection, float LocationError);
+
+	/** Counts a correction received by an autonomous proxy. */
+	ZIPPY_API void CountClientCorrection();
+
+	/** Counts the bits of a packed move sent to the server. */
+	ZIPPY_API void CountServerMoveBits(int32 NumBits);
+
+	/** Counts a multi result query made into a reused scratch buffer, and whether the buffer had room without growing. */
+	ZIPPY_API void CountScratchQuery(bool bReused);
+
+	/** Counts a PerformMovement call and how long it took. */
+	ZIPPY_API void CountPerformMovement(uint64 Cycles);
+
+	/** Counts a client replay of saved moves after a correction and how long it took. */
+	ZIPPY_API void CountReplay(uint64 Cycles);
+
+	/** Running totals since startup, never reset. Used by the movement benchmark to diff a run. */
+	struct FTotals
+	{
+		uint64 PerformMovementCycles = 0;
+		int64 PerformMovements = 0;
+		uint64 ReplayCycles = 0;
+		int64 Replays = 0;
+		int64 Traces = 0;
+		int64 ServerMoves = 0;
+		int64 ServerCorrections = 0;
+		int64 ClientCorrections = 0;
+		int64 ServerMovesSent = 0;
+		int64 BitsSent = 0;
+	};
+
+	/** @return The running totals since startup. */
+	ZIPPY_API const FTotals& GetTotals();
+
+	/** Publishes and resets the frame's totals. Bound to FCoreDelegates::OnEndFrame, so it runs once after everything has ticked. */
+	ZIPPY_API void FlushFrame();
+}
+
+#define SURVIVAL_COUNT_TRACES(MovementMode, CustomMovementMode, Count) SurvivalMovementStats::CountTraces(SurvivalMovementStats::GetMode(MovementMode, CustomMovementMode), Count)
+#define SURVIVAL_COUNT_SCRATCH_QUERY(bReused) SurvivalMovementStats::CountScratchQuery(bReused)
+
+#else
+
+#define SURVIVAL_SCOPE_CYCLE_COUNTER(Name)
+#define SURVIVAL_COUNT_TRACES(MovementMode, CustomMovementMode, Count)
+#define SURVIVAL_COUNT_SCRATCH_QUERY(bReused)
+
+#endif
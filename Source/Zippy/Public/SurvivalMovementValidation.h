@@ -0,0 +1,37 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Zippy.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "SurvivalMovementValidation.generated.h"
+
+class UNetConnection;
+
+/**
+ * Server side move validation state that belongs to a client connection rather than to the pawn it controls.
+ * Keeping the position error budget here means a client cannot refill it by respawning, and it survives seamless travel.
+ */
+UCLASS()
+class ZIPPY_API USurvivalMovementValidationSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Returns the position error budget of a connection, starting it at FullBudget the first time the connection is seen.
+	 * @param Connection The connection the client moves arrive on.
+	 * @param FullBudget The budget a new connection starts with.
+	 * @return The budget left for the connection, to spend or refill.
+	 */
+	float& GetPositionErrorBudget(const UNetConnection* Connection, float FullBudget);
+
+	/**
+	 * @param Connection The connection to look up.
+	 * @return The budget left for the connection, or null if no move from it has been checked yet.
+	 */
+	const float* FindPositionErrorBudget(const UNetConnection* Connection) const;
+
+private:
+	TMap<TObjectKey<UNetConnection>, float> PositionErrorBudgets;
+};
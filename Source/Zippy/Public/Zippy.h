@@ -5,8 +5,16 @@
 // Unreal Classes
 class USpringArmComponent;
 class UCameraComponent;
+class UInputMappingContext;
+class UInputAction;
+struct FInputActionValue;
 
 // Zippy Classes
 class AZippyCharacter;
 class USurvivalCharacterMovementComponent;
 class AZippyCameraManager;
+class UZippySpringArmComponent;
+class UClimbPointSubsystem;
+class USurvivalMovementBatchSubsystem;
+class USurvivalMovementSignificanceSubsystem;
+class USurvivalMovementValidationSubsystem;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Zippy.h"
 #include "Camera/PlayerCameraManager.h"
 #include "ZippyCameraManager.generated.h"
 
@@ -9,11 +10,50 @@ class ZIPPY_API AZippyCameraManager : public APlayerCameraManager
 {
 	GENERATED_BODY()
 
+	/** Camera states the view offset blends between. */
+	enum ECameraState : uint8
+	{
+		CAMERA_Standing,
+		CAMERA_Crouched,
+		CAMERA_Slide,
+		CAMERA_Prone,
+		CAMERA_Climb,
+		CAMERA_MAX
+	};
+
+	/** Time to blend the view offset from one camera state to the next. */
 	UPROPERTY(EditDefaultsOnly) float CrouchBlendDuration=.2f;
+
+	// Extra view offsets on top of the capsule height change, in world space
+	UPROPERTY(EditDefaultsOnly) FVector SlideViewOffset=FVector::ZeroVector;
+	UPROPERTY(EditDefaultsOnly) FVector ProneViewOffset=FVector::ZeroVector;
+	UPROPERTY(EditDefaultsOnly) FVector ClimbViewOffset=FVector::ZeroVector;
+
+	/** Pawn the cache below was built for, and its movement. Both go stale together when the pawn is destroyed. */
+	TWeakObjectPtr<AZippyCharacter> CachedCharacter;
+	TWeakObjectPtr<USurvivalCharacterMovementComponent> CachedMovement;
+
+	/** Offset the camera drops by when the capsule shrinks to its crouched height. */
+	FVector CrouchCapsuleOffset = FVector::ZeroVector;
+
+	/** Target view offset of each camera state, built once per possessed pawn. */
+	FVector StateOffsets[CAMERA_MAX];
+
+	/** Blend of the view offset between camera state targets. */
+	FVector BlendFrom = FVector::ZeroVector;
+	FVector BlendTarget = FVector::ZeroVector;
+	FVector BlendedOffset = FVector::ZeroVector;
 	float CrouchBlendTime;
 
 public:
 	AZippyCameraManager();
 
 	virtual void UpdateViewTarget(FTViewTarget& OutVT, float DeltaTime) override;
+
+private:
+	/** Rebuilds the per state offsets for a newly possessed pawn. */
+	void CacheCharacter(AZippyCharacter* ZippyCharacter);
+
+	/** @return The camera state for the character's current movement. */
+	ECameraState GetCameraState() const;
 };
@@ -19,12 +19,25 @@ private:
 public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category=Input) float TurnRateGamepad;
 
+	// Enhanced Input, each action is only bound when set and falls back to the legacy mappings otherwise
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=Input) UInputMappingContext* DefaultMappingContext;
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=Input) UInputAction* MoveAction;
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=Input) UInputAction* LookAction;
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=Input) UInputAction* JumpAction;
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=Input) UInputAction* CrouchAction;
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=Input) UInputAction* SlideAction;
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=Input) UInputAction* DashAction;
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=Input) UInputAction* ProneAction;
+
 public:
 	bool bPressedZippyJump;
 	
 public:
 	AZippyCharacter(const FObjectInitializer& ObjectInitializer);
 
+	virtual void PostInitializeComponents() override;
+	virtual void NotifyControllerChanged() override;
+
 	virtual void Jump() override;
 	virtual void StopJumping() override;
 
@@ -37,6 +50,22 @@ private:
 	void TouchStarted(ETouchIndex::Type FingerIndex, FVector Location);
 	void TouchStopped(ETouchIndex::Type FingerIndex, FVector Location);
 
+	void Move(const FInputActionValue& Value);
+	void Look(const FInputActionValue& Value);
+	void JumpReleased();
+	void CrouchPressed();
+	void CrouchReleased();
+
+	/** Buffered actions, Input is a USurvivalCharacterMovementComponent::EBufferedInput. */
+	void BufferedPressed(uint8 Input);
+	void BufferedReleased(uint8 Input);
+
+	/**
+	 * Adds movement input relative to the control yaw, building the rotation once for both axes.
+	 * @param Input Right/left in X, forward/backward in Y.
+	 */
+	void AddMoveInput(const FVector2D& Input);
+
 
 
 	// APawn interface
@@ -48,7 +77,19 @@ public:
 	FORCEINLINE UCameraComponent* GetFollowCamera() const { return FollowCamera; }
 	UFUNCTION(BlueprintPure) FORCEINLINE USurvivalCharacterMovementComponent* GetZippyCharacterMovement() const { return ZippyCharacterMovementComponent; }
 
-	FCollisionQueryParams GetIgnoreCharacterParams() const;
+	/**
+	 * Query params that ignore this character and all of its child actors.
+	 * Cached and only rebuilt after MarkIgnoreCharacterParamsDirty(), so movement queries never allocate.
+	 */
+	const FCollisionQueryParams& GetIgnoreCharacterParams() const;
+
+	/** Flags the cached ignore params for a rebuild. Call after child actors are attached or detached. */
+	UFUNCTION(BlueprintCallable) void MarkIgnoreCharacterParamsDirty() { bIgnoreCharacterParamsDirty = true; }
+
+private:
+	/** Cached result of GetIgnoreCharacterParams, rebuilt lazily when bIgnoreCharacterParamsDirty is set. */
+	mutable FCollisionQueryParams IgnoreCharacterParams;
+	mutable bool bIgnoreCharacterParamsDirty = true;
 
 };
 
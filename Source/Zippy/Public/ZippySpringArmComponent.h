@@ -0,0 +1,34 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/SpringArmComponent.h"
+#include "ZippySpringArmComponent.generated.h"
+
+/**
+ * Spring arm that skips its collision probe while the camera is stationary.
+ * If the arm's location and rotation, target rotation and length have not changed since the last update it keeps the last result,
+ * and only probes again every StationaryProbeInterval to catch geometry moving into the arm.
+ */
+UCLASS(ClassGroup=Camera, meta=(BlueprintSpawnableComponent))
+class ZIPPY_API UZippySpringArmComponent : public USpringArmComponent
+{
+	GENERATED_BODY()
+
+public:
+	/** How often the collision probe still runs while the camera is stationary. 0 probes every frame. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=CameraCollision, meta=(ClampMin="0", UIMin="0", ForceUnits="s"))
+	float StationaryProbeInterval = .25f;
+
+protected:
+	virtual void UpdateDesiredArmLocation(bool bDoTrace, bool bDoLocationLag, bool bDoRotationLag, float DeltaTime) override;
+
+private:
+	/** Inputs of the last full update, compared against to detect a stationary camera. */
+	FVector LastArmLocation = FVector::ZeroVector;
+	FQuat LastComponentRotation = FQuat::Identity;
+	FRotator LastTargetRotation = FRotator::ZeroRotator;
+	float LastArmLength = -1.f;
+
+	/** Time since the collision probe last ran. */
+	float TimeSinceProbe = 0.f;
+};